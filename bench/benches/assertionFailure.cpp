@@ -0,0 +1,37 @@
+#include <Bench.hpp>
+#include <Test.hpp>
+#include <sstream>
+
+using namespace gerryfudd::bench;
+using namespace gerryfudd::test;
+
+// Keeps the throw a few frames deep, like an assertion inside a helper inside a test.
+void __attribute__((noinline)) fail_at_depth(int depth) {
+  if (depth == 0) {
+    throw AssertionFailure("expected failure");
+  }
+  fail_at_depth(depth - 1);
+  do_not_optimize(depth);
+}
+
+BENCH(assertion_failure_throw_catch, {"depth", {1, 8}}) {
+  while (state.keep_running()) {
+    try {
+      fail_at_depth(state.arg(0));
+    } catch (AssertionFailure& e) {
+      do_not_optimize(e);
+    }
+  }
+}
+
+BENCH(assertion_failure_throw_catch_print, {"depth", {1, 8}}) {
+  std::stringstream out;
+  while (state.keep_running()) {
+    try {
+      fail_at_depth(state.arg(0));
+    } catch (AssertionFailure& e) {
+      out.str("");
+      out << e;
+    }
+  }
+}
@@ -0,0 +1,70 @@
+#include <Bench.hpp>
+#include <Operands.hpp>
+#include <math/BigInt.hpp>
+
+using namespace gerryfudd::math;
+using namespace gerryfudd::bench;
+
+// Values for the "signs" axis
+#define BOTH_POSITIVE 0
+#define MIXED_SIGNS 1
+#define BOTH_NEGATIVE 2
+
+BigInt first_operand(State& state) {
+  return random_big_int(state.arg(0), state.arg(1) == BOTH_NEGATIVE, 1);
+}
+
+BigInt second_operand(State& state) {
+  return random_big_int(state.arg(0), state.arg(1) != BOTH_POSITIVE, 2);
+}
+
+BENCH(add, {"words", {1, 4, 16, 64, 256, 1024}}, {"signs", {BOTH_POSITIVE, MIXED_SIGNS, BOTH_NEGATIVE}}) {
+  BigInt a = first_operand(state), b = second_operand(state), result;
+  state.set_words_processed(2 * state.arg(0));
+  while (state.keep_running()) {
+    result = a + b;
+  }
+}
+
+BENCH(subtract, {"words", {1, 4, 16, 64, 256, 1024}}, {"signs", {BOTH_POSITIVE, MIXED_SIGNS, BOTH_NEGATIVE}}) {
+  BigInt a = first_operand(state), b = second_operand(state), result;
+  state.set_words_processed(2 * state.arg(0));
+  while (state.keep_running()) {
+    result = a - b;
+  }
+}
+
+// 79, 80 and 81 straddle KARATSUBA_THRESHOLD.
+BENCH(mult, {"words", {1, 2, 4, 16, 64, 79, 80, 81, 128, 200}}, {"signs", {BOTH_POSITIVE, MIXED_SIGNS}}) {
+  BigInt a = first_operand(state), b = second_operand(state), result;
+  state.set_words_processed(2 * state.arg(0));
+  while (state.keep_running()) {
+    result = a * b;
+  }
+}
+
+BENCH(mult_by_one_word, {"words", {4, 64, 1024}}, {"signs", {BOTH_POSITIVE, MIXED_SIGNS}}) {
+  BigInt a = first_operand(state), b = random_big_int(1, state.arg(1) != BOTH_POSITIVE, 2), result;
+  state.set_words_processed(state.arg(0) + 1);
+  while (state.keep_running()) {
+    result = a * b;
+  }
+}
+
+BENCH(as_decimal_string, {"words", {1, 4, 16, 64, 256}}, {"signs", {BOTH_POSITIVE, BOTH_NEGATIVE}}) {
+  BigInt a = first_operand(state);
+  string result;
+  state.set_words_processed(state.arg(0));
+  while (state.keep_running()) {
+    result = a.as_decimal_string();
+  }
+}
+
+BENCH(as_hex_string, {"words", {1, 4, 16, 64, 256, 1024}}, {"signs", {BOTH_POSITIVE, BOTH_NEGATIVE}}) {
+  BigInt a = first_operand(state);
+  string result;
+  state.set_words_processed(state.arg(0));
+  while (state.keep_running()) {
+    result = a.as_hex_string();
+  }
+}
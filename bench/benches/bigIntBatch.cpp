@@ -0,0 +1,64 @@
+#include <Bench.hpp>
+#include <Operands.hpp>
+#include <math/BigIntBatch.hpp>
+
+using namespace gerryfudd::math;
+using namespace gerryfudd::bench;
+
+// Axis values are lanes, words per operand and, for the batch versions, threads (0 = automatic).
+#define BATCH_AXES {"lanes", {1024, 262144}}, {"words", {1, 2, 4, 8}}
+
+BigIntBatch as_batch(const vector<BigInt>& values, unsigned short width) {
+  BigIntBatch batch(values.size(), width);
+  for (unsigned long lane = 0; lane < values.size(); lane++) {
+    batch.set(lane, values[lane]);
+  }
+  return batch;
+}
+
+void batch_bench(State& state, void (*operation)(const BigIntBatch&, const BigIntBatch&, BigIntBatch&, unsigned int), unsigned short result_width) {
+  unsigned long lanes = state.arg(0), words = state.arg(1);
+  // One extra word leaves room for the sign bit of random operands
+  BigIntBatch a = as_batch(random_big_ints(lanes, words, true, 1), words + 1),
+    b = as_batch(random_big_ints(lanes, words, true, 2), words + 1),
+    result(lanes, result_width);
+  state.set_words_processed(2 * lanes * words);
+  while (state.keep_running()) {
+    operation(a, b, result, state.arg(2));
+  }
+}
+
+void per_object_bench(State& state, BigInt (*operation)(BigInt&, BigInt&)) {
+  unsigned long lanes = state.arg(0), words = state.arg(1);
+  vector<BigInt> a = random_big_ints(lanes, words, true, 1), b = random_big_ints(lanes, words, true, 2), result(lanes);
+  state.set_words_processed(2 * lanes * words);
+  while (state.keep_running()) {
+    for (unsigned long lane = 0; lane < lanes; lane++) {
+      result[lane] = operation(a[lane], b[lane]);
+    }
+  }
+}
+
+BENCH(batch_add_lanes, BATCH_AXES, {"threads", {1, 0}}) {
+  batch_bench(state, &batch_add, state.arg(1) + 2);
+}
+
+BENCH(per_object_add_lanes, BATCH_AXES) {
+  per_object_bench(state, [](BigInt& a, BigInt& b) { return a + b; });
+}
+
+BENCH(batch_sub_lanes, BATCH_AXES, {"threads", {1, 0}}) {
+  batch_bench(state, &batch_sub, state.arg(1) + 2);
+}
+
+BENCH(per_object_sub_lanes, BATCH_AXES) {
+  per_object_bench(state, [](BigInt& a, BigInt& b) { return a - b; });
+}
+
+BENCH(batch_mult_lanes, BATCH_AXES, {"threads", {1, 0}}) {
+  batch_bench(state, &batch_mult, 2 * state.arg(1) + 2);
+}
+
+BENCH(per_object_mult_lanes, BATCH_AXES) {
+  per_object_bench(state, [](BigInt& a, BigInt& b) { return a * b; });
+}
@@ -0,0 +1,25 @@
+#include <Bench.hpp>
+#include <Operands.hpp>
+#include <math/BigIntExpr.hpp>
+
+using namespace gerryfudd::math;
+using namespace gerryfudd::bench;
+
+// a + b - c + d - e, with every other operand negative when "signs" is 1
+BENCH(eager_five_terms, {"words", {4, 64, 1024}}, {"signs", {0, 1}}) {
+  vector<BigInt> terms = random_big_ints(5, state.arg(0), state.arg(1), 1);
+  BigInt result;
+  state.set_words_processed(5 * state.arg(0));
+  while (state.keep_running()) {
+    result = terms[0] + terms[1] - terms[2] + terms[3] - terms[4];
+  }
+}
+
+BENCH(lazy_five_terms, {"words", {4, 64, 1024}}, {"signs", {0, 1}}) {
+  vector<BigInt> terms = random_big_ints(5, state.arg(0), state.arg(1), 1);
+  BigInt result;
+  state.set_words_processed(5 * state.arg(0));
+  while (state.keep_running()) {
+    result = lazy(terms[0]) + terms[1] - terms[2] + terms[3] - terms[4];
+  }
+}
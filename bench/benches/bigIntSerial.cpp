@@ -0,0 +1,90 @@
+#include <Bench.hpp>
+#include <Operands.hpp>
+#include <fstream>
+#include <sstream>
+#include <math/BigIntSerial.hpp>
+
+using namespace gerryfudd::math;
+using namespace gerryfudd::bench;
+
+// Every case loads this many values of the given size.
+#define VALUE_COUNT 10000
+#define COLUMN_PATH "./build/bench_column.bin"
+
+BENCH(load_decimal_text, {"words", {4, 64}}) {
+  vector<BigInt> values = random_big_ints(VALUE_COUNT, state.arg(0), true, 1);
+  vector<string> text;
+  for (vector<BigInt>::iterator value = values.begin(); value != values.end(); value++) {
+    text.push_back(value->as_decimal_string());
+  }
+  state.set_words_processed(VALUE_COUNT * state.arg(0));
+  while (state.keep_running()) {
+    for (unsigned long i = 0; i < VALUE_COUNT; i++) {
+      values[i] = BigInt::from_decimal_string(text[i]);
+    }
+  }
+}
+
+BENCH(load_hex_text, {"words", {4, 64}}) {
+  vector<BigInt> values = random_big_ints(VALUE_COUNT, state.arg(0), true, 1);
+  vector<string> text;
+  for (vector<BigInt>::iterator value = values.begin(); value != values.end(); value++) {
+    text.push_back(value->as_hex_string());
+  }
+  state.set_words_processed(VALUE_COUNT * state.arg(0));
+  while (state.keep_running()) {
+    for (unsigned long i = 0; i < VALUE_COUNT; i++) {
+      values[i] = BigInt::from_hex_string(text[i]);
+    }
+  }
+}
+
+BENCH(load_binary_stream, {"words", {4, 64}}) {
+  vector<BigInt> values = random_big_ints(VALUE_COUNT, state.arg(0), true, 1);
+  stringstream encoded;
+  for (vector<BigInt>::iterator value = values.begin(); value != values.end(); value++) {
+    write_binary(encoded, *value);
+  }
+  string bytes = encoded.str();
+  state.set_words_processed(VALUE_COUNT * state.arg(0));
+  while (state.keep_running()) {
+    istringstream in(bytes);
+    for (unsigned long i = 0; i < VALUE_COUNT; i++) {
+      values[i] = read_binary(in);
+    }
+  }
+}
+
+void write_bench_column(State& state) {
+  ofstream out(COLUMN_PATH, ios::binary);
+  write_column(out, random_big_ints(VALUE_COUNT, state.arg(0), true, 1));
+}
+
+// Maps the file and reads every word through the views, without copying them
+BENCH(load_mapped_column_views, {"words", {4, 64}}) {
+  write_bench_column(state);
+  unsigned int checksum = 0;
+  state.set_words_processed(VALUE_COUNT * state.arg(0));
+  while (state.keep_running()) {
+    MappedBigIntColumn column(COLUMN_PATH);
+    for (unsigned long i = 0; i < column.size(); i++) {
+      BigIntView view = column[i];
+      for (size_t w = 0; w < view.length; w++) {
+        checksum += view.words[w];
+      }
+    }
+    do_not_optimize(checksum);
+  }
+}
+
+BENCH(load_mapped_column_copies, {"words", {4, 64}}) {
+  write_bench_column(state);
+  vector<BigInt> values(VALUE_COUNT);
+  state.set_words_processed(VALUE_COUNT * state.arg(0));
+  while (state.keep_running()) {
+    MappedBigIntColumn column(COLUMN_PATH);
+    for (unsigned long i = 0; i < column.size(); i++) {
+      values[i] = BigInt(column[i]);
+    }
+  }
+}
@@ -0,0 +1,41 @@
+#include <Bench.hpp>
+#include <exception_utils/enriched_exception.hpp>
+#include <sstream>
+
+using namespace gerryfudd::bench;
+using namespace gerryfudd::exception_utils;
+
+// 1e9 / ns_per_op is the number of exceptions one thread can throw and catch per second.
+const capture_level LEVELS[] = {capture_level::none, capture_level::addresses, capture_level::full};
+
+void __attribute__((noinline)) throw_at_depth(int depth, capture_level level) {
+  if (depth == 0) {
+    throw enriched_exception("expected failure", level);
+  }
+  throw_at_depth(depth - 1, level);
+  do_not_optimize(depth);
+}
+
+BENCH(enriched_exception_throw_catch, {"level", {0, 1, 2}}, {"depth", {1, 8}}) {
+  capture_level level = LEVELS[state.arg(0)];
+  while (state.keep_running()) {
+    try {
+      throw_at_depth(state.arg(1), level);
+    } catch (enriched_exception& e) {
+      do_not_optimize(e);
+    }
+  }
+}
+
+BENCH(enriched_exception_throw_catch_print, {"level", {0, 1, 2}}, {"depth", {1, 8}}) {
+  capture_level level = LEVELS[state.arg(0)];
+  std::stringstream out;
+  while (state.keep_running()) {
+    try {
+      throw_at_depth(state.arg(1), level);
+    } catch (enriched_exception& e) {
+      out.str("");
+      out << e;
+    }
+  }
+}
@@ -0,0 +1,74 @@
+#include <Bench.hpp>
+#include <Operands.hpp>
+#include <math/FixedInt.hpp>
+
+using namespace gerryfudd::math;
+using namespace gerryfudd::bench;
+
+// 7 random words keep the operands clear of the sign bit of a 256 bit value.
+#define OPERAND_WORDS 7
+
+BENCH(fixed_256_add, {"signs", {0, 1}}) {
+  FixedInt<256> a(random_big_int(OPERAND_WORDS, false, 1)), b(random_big_int(OPERAND_WORDS, state.arg(0), 2)), result;
+  state.set_words_processed(2 * FixedInt<256>::WORDS);
+  while (state.keep_running()) {
+    do_not_optimize(a);
+    result = a + b;
+    do_not_optimize(result);
+  }
+}
+
+BENCH(dynamic_256_add, {"signs", {0, 1}}) {
+  BigInt a = random_big_int(OPERAND_WORDS, false, 1), b = random_big_int(OPERAND_WORDS, state.arg(0), 2), result;
+  state.set_words_processed(2 * FixedInt<256>::WORDS);
+  while (state.keep_running()) {
+    result = a + b;
+  }
+}
+
+BENCH(fixed_256_sub, {"signs", {0, 1}}) {
+  FixedInt<256> a(random_big_int(OPERAND_WORDS, false, 1)), b(random_big_int(OPERAND_WORDS, state.arg(0), 2)), result;
+  state.set_words_processed(2 * FixedInt<256>::WORDS);
+  while (state.keep_running()) {
+    do_not_optimize(a);
+    result = a - b;
+    do_not_optimize(result);
+  }
+}
+
+BENCH(dynamic_256_sub, {"signs", {0, 1}}) {
+  BigInt a = random_big_int(OPERAND_WORDS, false, 1), b = random_big_int(OPERAND_WORDS, state.arg(0), 2), result;
+  state.set_words_processed(2 * FixedInt<256>::WORDS);
+  while (state.keep_running()) {
+    result = a - b;
+  }
+}
+
+// 256 x 256 -> 512 bits, the full product in both representations
+BENCH(fixed_512_mult, {"signs", {0, 1}}) {
+  FixedInt<512> a = FixedInt<256>(random_big_int(OPERAND_WORDS, false, 1)).resize<512>(),
+    b = FixedInt<256>(random_big_int(OPERAND_WORDS, state.arg(0), 2)).resize<512>(), result;
+  state.set_words_processed(2 * FixedInt<256>::WORDS);
+  while (state.keep_running()) {
+    do_not_optimize(a);
+    result = a * b;
+    do_not_optimize(result);
+  }
+}
+
+BENCH(dynamic_512_mult, {"signs", {0, 1}}) {
+  BigInt a = random_big_int(OPERAND_WORDS, false, 1), b = random_big_int(OPERAND_WORDS, state.arg(0), 2), result;
+  state.set_words_processed(2 * FixedInt<256>::WORDS);
+  while (state.keep_running()) {
+    result = a * b;
+  }
+}
+
+BENCH(fixed_256_to_big_int) {
+  FixedInt<256> a(random_big_int(OPERAND_WORDS, true, 1));
+  BigInt result;
+  state.set_words_processed(FixedInt<256>::WORDS);
+  while (state.keep_running()) {
+    result = a.to_big_int();
+  }
+}
@@ -0,0 +1,86 @@
+#ifndef BENCH_TYPE
+#define BENCH_TYPE
+#include <Benchmark.hpp>
+#include <MemoryTracking.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace gerryfudd::bench {
+  // Shared with the test binary
+  using test::do_not_optimize;
+  using test::allocation_counts;
+
+  /*
+    One axis of a parameter sweep, e.g. {"words", {1, 4, 16}}. A benchmark runs once for
+    every combination of the values on its axes.
+  */
+  struct Axis {
+    std::string name;
+    std::vector<long> values;
+  };
+
+  /*
+    Passed to every benchmark body. The body does its setup, then loops on keep_running()
+    around the code being measured. Only the loop is timed, and only its allocations counted.
+  */
+  class State: public test::BenchmarkState {
+      std::vector<long> args;
+      unsigned long words_per_iteration;
+      allocation_counts allocations_at_start, allocations_at_end;
+    protected:
+      void on_start() override;
+      void on_stop() override;
+    public:
+      State(std::vector<long>, unsigned long);
+      long arg(unsigned short) const;
+      void set_words_processed(unsigned long);
+
+      unsigned long words_processed() const;
+      allocation_counts allocations() const;
+  };
+
+  struct Result {
+    std::string name;
+    unsigned long iterations;
+    double ns_per_op;
+    double words_per_second;
+    double allocations_per_op;
+    double bytes_per_op;
+  };
+
+  class Bench {
+      std::string filename;
+      std::string name;
+      void (*exec)(State&);
+      std::vector<Axis> axes;
+    public:
+      Bench(const char *, const char *, void (*exec)(State&), std::vector<Axis>);
+      Bench(const char *, const char *, void (*exec)(State&));
+      std::string get_filename(void);
+      // Runs every combination in the sweep whose full name contains the filter.
+      void run(const std::string&, double, std::vector<Result>&, std::ostream&);
+  };
+
+  class Suite {
+      static std::vector<Bench> benches;
+    public:
+      static void add(Bench);
+      static int run_all(int, char **);
+  };
+
+  struct bench_registrar {
+    bench_registrar(Bench);
+  };
+
+  void write_json(const std::vector<Result>&, std::ostream&);
+}
+
+#define BENCH(name, ...) \
+void name(State&); \
+Bench name ## _bench(__FILE__, #name, &name __VA_OPT__(, {__VA_ARGS__})); \
+bench_registrar name ## _registered (name ## _bench); \
+void name(State& state)
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef OPERANDS_DEFS
+#define OPERANDS_DEFS
+#include <math/BigInt.hpp>
+
+namespace gerryfudd::bench {
+  // A BigInt with exactly the given number of pseudo-random words, the same for the same seed.
+  gerryfudd::math::BigInt random_big_int(unsigned long, bool, unsigned int);
+  // count values of the given number of words. When the flag is set every other value is negative.
+  std::vector<gerryfudd::math::BigInt> random_big_ints(unsigned long, unsigned long, bool, unsigned int);
+}
+#endif
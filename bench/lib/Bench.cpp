@@ -0,0 +1,211 @@
+#include <Bench.hpp>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <math/BigIntStats.hpp>
+#include <profiling/sampling_profiler.hpp>
+
+namespace gerryfudd::bench {
+  const double DEFAULT_MIN_TIME_SECONDS = 0.2;
+
+  State::State(std::vector<long> args, unsigned long max_iterations):
+    test::BenchmarkState(max_iterations), args{args}, words_per_iteration{0},
+    allocations_at_start{0, 0}, allocations_at_end{0, 0} {}
+
+  void State::on_start() {
+    allocations_at_start = test::process_allocations();
+  }
+
+  void State::on_stop() {
+    allocations_at_end = test::process_allocations();
+  }
+
+  long State::arg(unsigned short index) const {
+    return args[index];
+  }
+
+  void State::set_words_processed(unsigned long words) {
+    words_per_iteration = words;
+  }
+
+  unsigned long State::words_processed() const {
+    return words_per_iteration * iterations();
+  }
+
+  allocation_counts State::allocations() const {
+    return {
+      allocations_at_end.allocations - allocations_at_start.allocations,
+      allocations_at_end.bytes - allocations_at_start.bytes
+    };
+  }
+
+  Bench::Bench(const char *filename, const char *name, void (*exec)(State&), std::vector<Axis> axes):
+    filename{filename}, name{name}, exec{exec}, axes{axes} {}
+  Bench::Bench(const char *filename, const char *name, void (*exec)(State&)): Bench(filename, name, exec, {}) {}
+
+  std::string Bench::get_filename() {
+    return filename;
+  }
+
+  Result measure(const std::string& full_name, void (*exec)(State&), const std::vector<long>& args, double min_time_ns) {
+    State state = test::calibrate([exec, &args](unsigned long iterations) {
+      State state(args, iterations);
+      exec(state);
+      return state;
+    }, min_time_ns);
+    double elapsed = state.elapsed_ns();
+    allocation_counts allocations = state.allocations();
+    // A body that never looped reports zeros rather than dividing by no iterations.
+    double ops = state.iterations() > 0 ? (double) state.iterations() : 1;
+    return {
+      full_name,
+      state.iterations(),
+      elapsed / ops,
+      elapsed > 0 ? state.words_processed() * 1e9 / elapsed : 0,
+      allocations.allocations / ops,
+      allocations.bytes / ops
+    };
+  }
+
+  void print_result(const Result& result, std::ostream& out) {
+    out << std::left << std::setw(56) << result.name << std::right
+      << std::setw(14) << std::fixed << std::setprecision(1) << result.ns_per_op << " ns/op"
+      << std::setw(14) << std::setprecision(3) << result.words_per_second / 1e6 << " Mwords/s"
+      << std::setw(12) << std::setprecision(2) << result.allocations_per_op << " allocs/op"
+      << std::setw(12) << std::setprecision(1) << result.bytes_per_op << " B/op"
+      << std::endl;
+  }
+
+  void Bench::run(const std::string& filter, double min_time_ns, std::vector<Result>& results, std::ostream& out) {
+    std::vector<unsigned short> position(axes.size(), 0);
+    for (std::vector<Axis>::iterator axis = axes.begin(); axis != axes.end(); axis++) {
+      if (axis->values.empty()) {
+        return;
+      }
+    }
+
+    while (true) {
+      std::stringstream full_name;
+      std::vector<long> args;
+      full_name << name;
+      for (int i = 0; i < axes.size(); i++) {
+        args.push_back(axes[i].values[position[i]]);
+        full_name << "/" << axes[i].name << ":" << args.back();
+      }
+
+      if (full_name.str().find(filter) != std::string::npos) {
+        results.push_back(measure(full_name.str(), exec, args, min_time_ns));
+        print_result(results.back(), out);
+      }
+
+      // Advance the sweep like an odometer, last axis fastest.
+      int axis = axes.size() - 1;
+      while (axis >= 0 && ++position[axis] == axes[axis].values.size()) {
+        position[axis] = 0;
+        axis--;
+      }
+      if (axis < 0) {
+        return;
+      }
+    }
+  }
+
+  std::vector<Bench> Suite::benches;
+  void Suite::add(Bench b) {
+    Suite::benches.push_back(b);
+  }
+
+  bench_registrar::bench_registrar(Bench b) {
+    Suite::add(b);
+  }
+
+  void write_json(const std::vector<Result>& results, std::ostream& out) {
+    // One benchmark per line keeps the output readable in a plain text diff.
+    out << "{\"benchmarks\": [" << std::endl;
+    for (int i = 0; i < results.size(); i++) {
+      out << std::fixed
+        << "  {\"name\": \"" << results[i].name << "\""
+        << ", \"iterations\": " << results[i].iterations
+        << ", \"ns_per_op\": " << std::setprecision(2) << results[i].ns_per_op
+        << ", \"words_per_second\": " << std::setprecision(0) << results[i].words_per_second
+        << ", \"allocations_per_op\": " << std::setprecision(3) << results[i].allocations_per_op
+        << ", \"bytes_per_op\": " << std::setprecision(1) << results[i].bytes_per_op
+        << "}" << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+    out << "]}" << std::endl;
+  }
+
+  const char *option_value(const char *arg, const char *option) {
+    size_t length = std::strlen(option);
+    if (std::strncmp(arg, option, length) == 0) {
+      return arg + length;
+    }
+    return nullptr;
+  }
+
+  int Suite::run_all(int argc, char **argv) {
+    std::string filter, output_path, profile_path;
+    double min_time_ns = DEFAULT_MIN_TIME_SECONDS * 1e9;
+    const char *value;
+
+    for (int i = 1; i < argc; i++) {
+      if ((value = option_value(argv[i], "--filter=")) != nullptr) {
+        filter = value;
+      } else if ((value = option_value(argv[i], "--out=")) != nullptr) {
+        output_path = value;
+      } else if ((value = option_value(argv[i], "--min-time=")) != nullptr) {
+        min_time_ns = std::strtod(value, nullptr) * 1e9;
+      } else if ((value = option_value(argv[i], "--profile=")) != nullptr) {
+        profile_path = value;
+      } else {
+        std::cerr << "Unknown option " << argv[i] << std::endl
+          << "Usage: " << argv[0] << " [--filter=<substring>] [--min-time=<seconds>] [--out=<json file>]"
+          << " [--profile=<folded stacks file>]" << std::endl;
+        return 1;
+      }
+    }
+
+    std::ofstream profile;
+    if (!profile_path.empty()) {
+      profile.open(profile_path);
+      if (!profile) {
+        std::cerr << "Unable to write the profile to " << profile_path << std::endl;
+        return 1;
+      }
+      profiling::start_profiling();
+    }
+
+    std::vector<Result> results;
+    std::string current_file;
+    for (std::vector<Bench>::iterator current_bench = benches.begin(); current_bench != benches.end(); current_bench++) {
+      if (current_file != current_bench->get_filename()) {
+        current_file = current_bench->get_filename();
+        std::cout << std::endl << "Bench file: " << current_file << std::endl << std::endl;
+      }
+      current_bench->run(filter, min_time_ns, results, std::cout);
+    }
+
+    if (math::big_int_stats_enabled) {
+      std::cout << std::endl << "BigInt kernels, including calibration runs:" << std::endl;
+      math::dump_big_int_stats(std::cout);
+    }
+
+    if (!profile_path.empty()) {
+      profiling::stop_profiling();
+      profiling::write_folded(profile);
+      std::cout << std::endl << "Wrote " << profiling::profile_so_far().samples << " samples to " << profile_path << std::endl;
+    }
+
+    if (!output_path.empty()) {
+      std::ofstream json(output_path);
+      if (!json) {
+        std::cerr << "Unable to write benchmark results to " << output_path << std::endl;
+        return 1;
+      }
+      write_json(results, json);
+      std::cout << std::endl << "Wrote " << results.size() << " results to " << output_path << std::endl;
+    }
+    return 0;
+  }
+}
@@ -0,0 +1,29 @@
+#include <Operands.hpp>
+#include <random>
+
+namespace gerryfudd::bench {
+  gerryfudd::math::BigInt next_big_int(std::mt19937& generator, unsigned long words, bool sign) {
+    std::vector<unsigned int> magnitude;
+    for (unsigned long i = 0; i < words; i++) {
+      magnitude.push_back(generator());
+    }
+    if (magnitude.back() == 0) {
+      magnitude.back() = 1;
+    }
+    return gerryfudd::math::BigInt(magnitude, sign);
+  }
+
+  gerryfudd::math::BigInt random_big_int(unsigned long words, bool sign, unsigned int seed) {
+    std::mt19937 generator(seed);
+    return next_big_int(generator, words, sign);
+  }
+
+  std::vector<gerryfudd::math::BigInt> random_big_ints(unsigned long count, unsigned long words, bool mixed_signs, unsigned int seed) {
+    std::mt19937 generator(seed);
+    std::vector<gerryfudd::math::BigInt> result;
+    for (unsigned long i = 0; i < count; i++) {
+      result.push_back(next_big_int(generator, words, mixed_signs && i % 2 == 1));
+    }
+    return result;
+  }
+}
@@ -0,0 +1,7 @@
+#include <Bench.hpp>
+
+using namespace gerryfudd::bench;
+
+int main(int argc, char **argv) {
+    return Suite::run_all(argc, argv);
+}
@@ -0,0 +1,14 @@
+#!/bin/bash
+
+bench_lib_include='./bench/include';
+test_lib_include='./test/include';
+project_include='./include';
+
+cpp_version=c++20;
+
+mkdir -p ./build;
+
+/usr/bin/gcc -std=${cpp_version} -O3 -pthread -I${bench_lib_include} -I${test_lib_include} -I${project_include} ./lib/**/*.cpp ./bench/lib/*.cpp ./test/lib/Benchmark.cpp ./test/lib/MemoryTracking.cpp ./test/lib/Test.cpp ./bench/benches/*.cpp ./bench/main.cpp -lunwind -lstdc++ -o ./build/bench;
+
+# Pass --filter=<substring> or --min-time=<seconds> through. Diff bench.json between commits to spot regressions.
+./build/bench --out=./build/bench.json "$@"
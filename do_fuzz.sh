@@ -0,0 +1,13 @@
+#!/bin/bash
+
+fuzz_lib_include='./fuzz/include';
+project_include='./include';
+
+cpp_version=c++20;
+
+mkdir -p ./build;
+
+/usr/bin/gcc -std=${cpp_version} -O3 -pthread -I${fuzz_lib_include} -I${project_include} ./lib/**/*.cpp ./fuzz/lib/*.cpp ./fuzz/main.cpp -lunwind -lstdc++ -o ./build/fuzz;
+
+# Pass --seconds=<s>, --threads=<n>, --check=<substring> or the --seed=<n> of a failing run through.
+./build/fuzz "$@"
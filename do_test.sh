@@ -5,6 +5,8 @@ project_include='./include';
 
 cpp_version=c++20;
 
-/usr/bin/gcc -std=${cpp_version} -I${test_lib_include} -I${project_include} ./lib/**/*.cpp ./test/lib/*.cpp ./test/tests/*.cpp ./test/main.cpp -lunwind -lstdc++ -o ./build/tests;
+mkdir -p ./build;
 
-./build/tests
+/usr/bin/gcc -std=${cpp_version} -I${test_lib_include} -I${project_include} -pthread ./lib/**/*.cpp ./test/lib/*.cpp ./test/tests/*.cpp ./test/main.cpp -lunwind -lstdc++ -o ./build/tests;
+
+./build/tests --timings=./build/test_timings.json "$@"
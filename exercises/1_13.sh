@@ -1,15 +1,30 @@
 cpp_version=c++17;
+shared_headers=./exercises/headers
+. ./exercises/lib/bigfile.sh
 
-c++ -std=${cpp_version} ./exercises/Chapter_1/1_13.cpp;
+c++ -std=${cpp_version} -O2 -pthread -I${shared_headers} ./exercises/lib/*.cpp ./exercises/Chapter_1/1_13.cpp;
 
-./a.out <<END
-This is a chunk of text with words of varrying sizes.
+text="This is a chunk of text with words of varrying sizes.
 It is a block that spans multiple lines; it even gets rather sesquepedalian.
 Some words aren't all letters, some are even far-fetched, which makes this tricky.
-There is 1 numerical.
-END
+There is 1 numerical."
+
+echo "$text" | ./a.out
+echo "$text" | ./a.out -c
+echo "$text" | ./a.out -c -j 4
 
 # Expected results
 # 1: 3, 2: 7, 3: 2, 4: 10, 5: 11, 6: 2, 7: 1, 8: 2, 9: 1, 10: 1, 14: 1
 
+# Pass a size in GB, e.g. ./exercises/1_13.sh 4, to time one thread against one per core on that much lorem ipsum.
+gigabytes=${1:-0}
+if [ "$gigabytes" -gt 0 ]; then
+  big=$(bigfile ./exercises/lorem_ipsum.txt $((gigabytes << 30)))
+
+  time ./a.out -c < $big
+  time ./a.out -c -j $(nproc) < $big
+
+  rm $big
+fi
+
 rm ./a.out
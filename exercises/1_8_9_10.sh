@@ -0,0 +1,37 @@
+cpp_version=c++17;
+shared_headers=./exercises/headers
+. ./exercises/lib/bigfile.sh
+
+c++ -std=${cpp_version} -O2 -I${shared_headers} ./exercises/lib/*.cpp ./exercises/Chapter_1/1_8.cpp -o 1_8
+c++ -std=${cpp_version} -O2 -I${shared_headers} ./exercises/lib/*.cpp ./exercises/Chapter_1/1_9.cpp -o 1_9
+c++ -std=${cpp_version} -O2 -I${shared_headers} ./exercises/lib/*.cpp ./exercises/Chapter_1/1_10.cpp -o 1_10
+c++ -std=${cpp_version} -O2 -I${shared_headers} ./exercises/lib/*.cpp ./exercises/Chapter_1/1_8_9_10.cpp -o 1_8_9_10
+
+printf 'Text with  several\tblanks\tand a \\ and a \b.\n' | ./1_8_9_10 count escape squeeze
+
+# Expected results
+# Text with several\tblanks\tand a \\ and a \b.
+# There are 10 blanks.
+
+# Pass a size in MB, e.g. ./exercises/1_8_9_10.sh 1000, to time the filters against the
+# getchar() loops with -c on that much lorem ipsum, with a tab in place of every " of " (default 200).
+megabytes=${1:-200}
+seed=$(mktemp)
+sed 's/ of /\t of  /g' ./exercises/lorem_ipsum.txt > $seed
+big=$(bigfile $seed $((megabytes << 20)))
+rm $seed
+
+rate() {
+  start=$(date +%s%N)
+  "$@" < $big > /dev/null 2>&1
+  end=$(date +%s%N)
+  echo "$*: $(( (megabytes << 20) / ((end - start) / 1000) )) MB/s"
+}
+for program in ./1_8 ./1_9 ./1_10; do
+  rate $program -c
+  rate $program
+done
+rate ./1_8_9_10 count squeeze escape
+
+rm $big
+rm ./1_8 ./1_9 ./1_10 ./1_8_9_10
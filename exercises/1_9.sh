@@ -1,6 +1,6 @@
 cpp_version=c++17;
 
-c++ -std=${cpp_version} ./exercises/Chapter_1/1_9.cpp;
+c++ -std=${cpp_version} -I./exercises/headers ./exercises/lib/*.cpp ./exercises/Chapter_1/1_9.cpp;
 
 echo "Text with  several\tblanks" | ./a.out
 
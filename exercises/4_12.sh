@@ -1,7 +1,14 @@
 cpp_version=c++17;
+shared_headers=./exercises/headers
 
-c++ -std=${cpp_version} ./exercises/Chapter_4/4_12.cpp;
+c++ -std=${cpp_version} -I${shared_headers} ./exercises/lib/*.cpp ./exercises/Chapter_4/4_12.cpp;
 
 ./a.out
 
+# Expected results
+# 19026
+# -824
+# 255
+# -2147483648
+
 rm ./a.out
@@ -0,0 +1,17 @@
+cpp_version=c++17;
+shared_headers=./exercises/headers
+
+c++ -std=${cpp_version} -O2 -I${shared_headers} ./exercises/lib/*.cpp ./exercises/Chapter_4/4_12_bench.cpp;
+
+# Each mode writes the same numbers, so the byte counts and hashes agree within int32 and int64.
+# Pass a count in millions, e.g. ./exercises/4_12_bench.sh 100, to format that many (default 10).
+millions=${1:-10}
+
+for mode in recursive snprintf format batch; do
+  ./a.out $mode $millions
+done
+for mode in snprintf format batch; do
+  ./a.out -l $mode $millions
+done
+
+rm ./a.out
@@ -0,0 +1,55 @@
+cpp_version=c++17;
+shared_headers=./exercises/headers
+
+c++ -std=${cpp_version} -O2 -I${shared_headers} -I./exercises/Chapter_5/5_1/headers -I./exercises/Chapter_5/5_2/headers \
+  ./exercises/lib/*.cpp \
+  ./exercises/Chapter_5/5_1/lib/*.cpp \
+  ./exercises/Chapter_5/5_2/lib/*.cpp \
+  ./exercises/Chapter_5/5_1_5_2.cpp;
+
+echo "- + 38 -14 +894 + 9223372036854775807 -9223372036854775808 9223372036854775808" | ./a.out ints
+echo "- + 38 -14. +894.0 23.92 .43 -.89 +.24 0.093 + 6.02e23 0.1000000000000000055511151231257827 1e400" | ./a.out doubles
+
+# Expected results
+# offset 0: not a number
+# offset 2: not a number
+# 38
+# -14
+# 894
+# offset 16: not a number
+# 9223372036854775807
+# -9223372036854775808
+# offset 59: out of range
+# offset 0: not a number
+# offset 2: not a number
+# 38
+# -14
+# 894
+# 23.920000000000002
+# 0.42999999999999999
+# -0.89000000000000001
+# 0.23999999999999999
+# 0.092999999999999999
+# offset 45: not a number
+# 6.02e+23
+# 0.10000000000000001
+# offset 92: out of range
+
+# Time a million of each against getint and getfloat, checking every double against strtod.
+numbers=$(mktemp)
+awk 'BEGIN { srand(7); for (i = 0; i < 1000000; i++) printf "%d ", int((rand() - 0.5) * 4e9) }' > $numbers
+./a.out ints -q < $numbers
+./a.out ints -q -c < $numbers
+awk 'BEGIN { srand(7); for (i = 0; i < 1000000; i++) printf "%.*f ", int(rand() * 12), (rand() - 0.5) * 10 ^ int(rand() * 10) }' > $numbers
+echo "1.7976931348623157e308 4.9e-324 2.2250738585072011e-308 123456789012345678901234567890 0.000000000000000000000001" >> $numbers
+./a.out doubles -q -v < $numbers
+./a.out doubles -q < $numbers
+./a.out doubles -q -c < $numbers
+# Prices, which all take the fast path
+awk 'BEGIN { srand(7); for (i = 0; i < 1000000; i++) printf "%.2f ", (rand() - 0.5) * 10000 }' > $numbers
+./a.out doubles -q -v < $numbers
+./a.out doubles -q < $numbers
+./a.out doubles -q -c < $numbers
+
+rm $numbers
+rm ./a.out
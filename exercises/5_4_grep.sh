@@ -0,0 +1,35 @@
+cpp_version=c++17;
+shared_headers=./exercises/headers
+. ./exercises/lib/bigfile.sh
+
+c++ -std=${cpp_version} -O2 -I${shared_headers} ./exercises/lib/*.cpp ./exercises/Chapter_5/5_4_grep.cpp;
+
+./a.out "adipiscing elit. Duis ornare" < ./exercises/lorem_ipsum.txt | cut -c 1-60
+./a.out -c -s "dictum." < ./exercises/lorem_ipsum.txt | cut -d , -f 1
+
+# Expected results
+# Etiam ac vehicula ante, eget vulputate ex. Vestibulum commod
+# 2 lines matched
+
+# Pass a size in MB, e.g. ./exercises/5_4_grep.sh 100, to time each search against the naive
+# scan on that much lorem ipsum, with 2000 random patterns and 3 real ones for -f. The naive -f
+# scan tries every pattern at every offset, so it only gets the first MB.
+megabytes=${1:-0}
+if [ "$megabytes" -gt 0 ]; then
+  big=$(bigfile ./exercises/lorem_ipsum.txt $((megabytes << 20)))
+  patterns=$(mktemp)
+  awk 'BEGIN { srand(5); for (i = 0; i < 2000; i++) { s = ""; for (j = 0; j < 7; j++) s = s sprintf("%c", 97 + int(rand() * 26)); print s } print "Nullam"; print "tempor i"; print "ipsum." }' > $patterns
+
+  for search in "consectetur adipiscing elit. Nulla" "-s dictum."; do
+    echo "$search"
+    ./a.out -c $search < $big
+    ./a.out -c -n $search < $big
+  done
+  echo "-f $patterns"
+  ./a.out -c -f $patterns < $big
+  head -c $((1 << 20)) $big | ./a.out -c -n -f $patterns
+
+  rm $big $patterns
+fi
+
+rm ./a.out
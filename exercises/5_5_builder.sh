@@ -0,0 +1,17 @@
+cpp_version=c++17;
+shared_headers=./exercises/headers
+
+c++ -std=${cpp_version} -O2 -I${shared_headers} ./exercises/lib/*.cpp ./exercises/Chapter_5/5_5_builder.cpp;
+
+# Each mode builds the same string from small fragments of lorem ipsum, so lengths and hashes agree.
+# Pass a size in MB, e.g. ./exercises/5_5_builder.sh 1000, to build that much (default 100). Every
+# strncat in rescan mode walks the whole string so far, so it only builds 1 MB.
+megabytes=${1:-100}
+
+./a.out rescan 1 < ./exercises/lorem_ipsum.txt
+./a.out end 1 < ./exercises/lorem_ipsum.txt
+for mode in end builder rope string; do
+  ./a.out $mode $megabytes < ./exercises/lorem_ipsum.txt
+done
+
+rm ./a.out
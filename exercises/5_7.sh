@@ -1,8 +1,28 @@
+. ./exercises/lib/bigfile.sh
+
 g++ -std=c++20 -I./exercises/headers ./exercises/lib/*.cpp ./exercises/Chapter_5/5_7_baseline.cpp -o 5_7_old
 g++ -std=c++20 -I./exercises/headers ./exercises/lib/*.cpp ./exercises/Chapter_5/5_7.cpp -o 5_7_new
+g++ -std=c++20 -I./exercises/headers ./exercises/lib/*.cpp ./exercises/Chapter_5/5_7_mapped.cpp -o 5_7_mapped
 
 cat ./exercises/lorem_ipsum.txt | ./5_7_old
 cat ./exercises/lorem_ipsum.txt | ./5_7_new
+cat ./exercises/lorem_ipsum.txt | ./5_7_mapped
+./5_7_mapped < ./exercises/lorem_ipsum.txt
+
+# Pass a size in GB, e.g. ./exercises/5_7.sh 4, to also time all three on that much lorem ipsum.
+# The old and new readlines stop at 1000 lines, so only the mapped one gets through it.
+gigabytes=${1:-0}
+if [ "$gigabytes" -gt 0 ]; then
+  big=$(bigfile ./exercises/lorem_ipsum.txt $((gigabytes << 30)))
+
+  ./5_7_old < $big
+  ./5_7_new < $big
+  cat $big | ./5_7_mapped
+  ./5_7_mapped < $big
+
+  rm $big
+fi
 
 rm ./5_7_old
 rm ./5_7_new
+rm ./5_7_mapped
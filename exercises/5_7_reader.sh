@@ -0,0 +1,18 @@
+cpp_version=c++17;
+shared_headers=./exercises/headers
+. ./exercises/lib/bigfile.sh
+
+c++ -std=${cpp_version} -O2 -I${shared_headers} ./exercises/lib/*.cpp ./exercises/Chapter_5/5_7_reader.cpp;
+
+# getline and getch read through one buffered reader on stdin; getchar is the old getline.
+# Pass a size in MB, e.g. ./exercises/5_7_reader.sh 1000, to read that much lorem ipsum (default 100).
+megabytes=${1:-100}
+big=$(bigfile ./exercises/lorem_ipsum.txt $((megabytes << 20)))
+
+./a.out getchar < $big
+./a.out getline < $big
+./a.out getch < $big
+cat $big | ./a.out getline
+
+rm $big
+rm ./a.out
@@ -0,0 +1,35 @@
+cpp_version=c++20;
+shared_headers=./exercises/headers
+exercise_headers=./exercises/Chapter_5/5_7_sort/headers
+. ./exercises/lib/bigfile.sh
+
+g++ -std=${cpp_version} -O2 -pthread -I${shared_headers} -I${exercise_headers} \
+  ./exercises/lib/*.cpp \
+  ./exercises/Chapter_5/5_7_sort/lib/*.cpp \
+  ./exercises/Chapter_5/5_7_sort/main.cpp;
+
+# Both should match sort in the C locale, which also compares bytes. No diff output means they do.
+./a.out < ./exercises/lorem_ipsum.txt | diff - <(LC_ALL=C sort ./exercises/lorem_ipsum.txt)
+./a.out -r 100 < ./exercises/lorem_ipsum.txt | diff - <(LC_ALL=C sort ./exercises/lorem_ipsum.txt)
+# From a pipe the input is streamed, a batch at a time.
+cat ./exercises/lorem_ipsum.txt | ./a.out | diff - <(LC_ALL=C sort ./exercises/lorem_ipsum.txt)
+cat ./exercises/lorem_ipsum.txt | ./a.out -r 100 | diff - <(LC_ALL=C sort ./exercises/lorem_ipsum.txt)
+
+./a.out -q -b < ./exercises/lorem_ipsum.txt
+./a.out -q < ./exercises/lorem_ipsum.txt
+
+# Pass a size in GB, e.g. ./exercises/5_7_sort.sh 4, to time both on that much lorem ipsum,
+# once more with runs of a million lines spilled to temporary files and merged, and once streamed from a pipe.
+gigabytes=${1:-0}
+if [ "$gigabytes" -gt 0 ]; then
+  big=$(bigfile ./exercises/lorem_ipsum.txt $((gigabytes << 30)))
+
+  ./a.out -q -b < $big
+  ./a.out -q < $big
+  ./a.out -q -r 1000000 < $big
+  cat $big | ./a.out -q
+
+  rm $big
+fi
+
+rm ./a.out
@@ -1,4 +1,6 @@
-g++ -std=c++20 ./exercises/Chapter_5/5_8.cpp
+shared_headers=./exercises/headers
+
+g++ -std=c++20 -I${shared_headers} ./exercises/lib/*.cpp ./exercises/Chapter_5/5_8.cpp
 
 ./a.out
 
@@ -0,0 +1,14 @@
+cpp_version=c++17;
+shared_headers=./exercises/headers
+
+c++ -std=${cpp_version} -O2 -I${shared_headers} ./exercises/lib/*.cpp ./exercises/Chapter_5/5_8_bench.cpp;
+
+# looped and table print the same checksum, as do sscanf and parse.
+# Pass a count in millions, e.g. ./exercises/5_8_bench.sh 100, to convert that many (default 10).
+millions=${1:-10}
+
+for mode in looped table civil sscanf parse; do
+  ./a.out $mode $millions
+done
+
+rm ./a.out
@@ -1,6 +1,10 @@
 #include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "filters.h"
 
-int main() {
+// The original loop, one getchar() per character; run it with -c to compare.
+int escape_per_char() {
   int c;
   while ((c = getchar()) != EOF) {
     if (c == '\t') {
@@ -16,4 +20,13 @@ int main() {
       putchar(c);
     }
   }
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc > 1 && strcmp(argv[1], "-c") == 0) {
+    return escape_per_char();
+  }
+  escapespecials escape;
+  return runfilters(0, stdout, std::vector<filter *>{&escape}) < 0 ? 1 : 0;
 }
@@ -1,44 +1,196 @@
+#include <stdint.h>
 #include <stdio.h>
-#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "mappedlines.h"
 
-#define MAXLEN 20
+// What each byte does to the word it is in
+enum { ENDS, EXTENDS, IGNORED };
 
-int main() {
-  int c, current_length = 0, longest_word = 0, highest_count = 0;
-  int histogram[MAXLEN];
-  for (int i = 0; i < MAXLEN; i++) {
-    histogram[i] = 0;
+struct byteclasses {
+  unsigned char of[256];
+};
+
+// Letters and digits make up words; apostrophes and hyphens sit inside them without counting.
+constexpr byteclasses makeclasses() {
+  byteclasses classes{};
+  for (int c = 0; c < 256; c++) {
+    bool alnum = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+    classes.of[c] = alnum ? EXTENDS : (c == '\'' || c == '-') ? IGNORED : ENDS;
+  }
+  return classes;
+}
+
+constexpr byteclasses classes = makeclasses();
+
+// histogram[i] counts the words of length i + 1, and grows to fit the longest word.
+void addword(std::vector<long> &histogram, long length) {
+  if ((long) histogram.size() < length) {
+    histogram.resize(length, 0);
+  }
+  histogram[length - 1]++;
+}
+
+// Bit i of *extends and *ends says what byte i of the n at p does to its word.
+void classify(const char *p, size_t n, uint64_t *extends, uint64_t *ends) {
+  uint64_t e = 0, x = 0;
+#ifdef __SSE2__
+  if (n == 64) {
+    for (int k = 0; k < 4; k++) {
+      __m128i v = _mm_loadu_si128((const __m128i *) (p + 16 * k));
+      // Unsigned range checks as signed compares: shifting by 0x80 more maps 0 to -128.
+      __m128i lower = _mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a' + 0x80));
+      __m128i digit = _mm_sub_epi8(v, _mm_set1_epi8('0' + 0x80));
+      __m128i alnum = _mm_or_si128(_mm_cmplt_epi8(lower, _mm_set1_epi8(-0x80 + 26)), _mm_cmplt_epi8(digit, _mm_set1_epi8(-0x80 + 10)));
+      __m128i inside = _mm_or_si128(alnum, _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\'')), _mm_cmpeq_epi8(v, _mm_set1_epi8('-'))));
+      x |= (uint64_t) (unsigned) _mm_movemask_epi8(alnum) << (16 * k);
+      e |= (uint64_t) (unsigned) (~_mm_movemask_epi8(inside) & 0xffff) << (16 * k);
+    }
+    *extends = x;
+    *ends = e;
+    return;
+  }
+#endif
+  for (size_t i = 0; i < n; i++) {
+    unsigned char c = classes.of[(unsigned char) p[i]];
+    x |= (uint64_t) (c == EXTENDS) << i;
+    e |= (uint64_t) (c == ENDS) << i;
   }
+  *extends = x;
+  *ends = e;
+}
+
+// Words shorter than this are counted in a fixed array first.
+#define SHORTWORD 64
 
-  while ((c = getchar()) != EOF) {
-    if (isalpha(c) || isdigit(c)) {
-      if (current_length == MAXLEN) {
-        printf("Current word exceeds maximum word length %d.\n", MAXLEN);
-        return 1;
+/*
+  Takes 64 bytes at a time as bit masks, so each word costs a popcount of its letters instead
+  of a branch per byte.
+*/
+void countwords(const char *p, const char *end, std::vector<long> &histogram) {
+  // shortcounts[0] takes the ends of no word, like a second space.
+  long shortcounts[SHORTWORD] = {0}, length = 0;
+  uint64_t extends, ends;
+  for (; p < end; p += 64) {
+    size_t n = end - p < 64 ? end - p : 64;
+    classify(p, n, &extends, &ends);
+    while (ends != 0) {
+      int i = __builtin_ctzll(ends);
+      length += __builtin_popcountll(extends & ((1ULL << i) - 1));
+      extends &= ~((2ULL << i) - 1);
+      if (length < SHORTWORD) {
+        shortcounts[length]++;
+      } else {
+        addword(histogram, length);
       }
-      current_length++;
-    } else if (c != '\'' && c != '-') {
-      if (current_length > 0) {
-        if (current_length > longest_word) {
-          longest_word = current_length;
-        }
-        histogram[current_length-1]++;
-        if (histogram[current_length-1] > highest_count) {
-          highest_count = histogram[current_length-1];
-        }
+      length = 0;
+      ends &= ends - 1;
+    }
+    length += __builtin_popcountll(extends);
+  }
+  if (length > 0) {
+    addword(histogram, length);
+  }
+  for (long i = SHORTWORD - 1; i > 0; i--) {
+    if (shortcounts[i] > 0) {
+      if ((long) histogram.size() < i) {
+        histogram.resize(i, 0);
       }
-      current_length = 0;
+      histogram[i - 1] += shortcounts[i];
     }
   }
-  if (current_length > 0) {
-    if (current_length > longest_word) {
-      longest_word = current_length;
+}
+
+// Splits the input into nthreads chunks that each start at a byte ending a word, so no word is cut in two.
+std::vector<long> countchunks(const char *data, size_t len, unsigned nthreads) {
+  std::vector<size_t> bounds(nthreads + 1, len);
+  bounds[0] = 0;
+  for (unsigned i = 1; i < nthreads; i++) {
+    size_t b = len / nthreads * i;
+    if (b < bounds[i - 1]) {
+      b = bounds[i - 1];
     }
-    histogram[current_length-1]++;
+    while (b < len && classes.of[(unsigned char) data[b]] != ENDS) {
+      b++;
+    }
+    bounds[i] = b;
+  }
+
+  std::vector<std::vector<long>> histograms(nthreads);
+  std::vector<std::thread> workers;
+  for (unsigned i = 0; i < nthreads; i++) {
+    workers.emplace_back([&, i]() {
+      countwords(data + bounds[i], data + bounds[i + 1], histograms[i]);
+    });
+  }
+  std::vector<long> histogram;
+  for (unsigned i = 0; i < nthreads; i++) {
+    workers[i].join();
+    if (histogram.size() < histograms[i].size()) {
+      histogram.resize(histograms[i].size(), 0);
+    }
+    for (size_t j = 0; j < histograms[i].size(); j++) {
+      histogram[j] += histograms[i][j];
+    }
+  }
+  return histogram;
+}
+
+/*
+  Prints a histogram of word lengths in stdin.
+    -j n  count on n threads
+    -c    print "length: count" pairs instead of bars, for inputs too large to draw
+*/
+int main(int argc, char *argv[]) {
+  unsigned nthreads = 1;
+  bool counts = false;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+      nthreads = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-c") == 0) {
+      counts = true;
+    } else {
+      printf("usage: %s [-j threads] [-c] < input\n", argv[0]);
+      return 1;
+    }
+  }
+  if (nthreads < 1) {
+    nthreads = 1;
+  }
+
+  struct input in;
+  if (readinput(0, &in) < 0) {
+    printf("Could not read input.\n");
+    return 1;
+  }
+  std::vector<long> histogram = countchunks(in.data, in.len, nthreads);
+  freeinput(&in);
+  int longest_word = histogram.size();
+  long highest_count = 0;
+  for (int i = 0; i < longest_word; i++) {
+    if (histogram[i] > highest_count) {
+      highest_count = histogram[i];
+    }
+  }
+
+  if (counts) {
+    for (int i = 0, first = 1; i < longest_word; i++) {
+      if (histogram[i] > 0) {
+        printf("%s%d: %ld", first ? "" : ", ", i + 1, histogram[i]);
+        first = 0;
+      }
+    }
+    printf("\n");
+    return 0;
   }
 
   printf("Histogram by count\n");
-  for (int h = highest_count; h > 0; h--) {
+  for (long h = highest_count; h > 0; h--) {
     for (int i = 0; i < longest_word; i++) {
       if (histogram[i] >= h) {
         printf(" #");
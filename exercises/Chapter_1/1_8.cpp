@@ -1,7 +1,11 @@
 #include <stdio.h>
 #include <ctype.h>
+#include <string.h>
+#include <vector>
+#include "filters.h"
 
-int main() {
+// The original loop, one getchar() per character; run it with -c to compare.
+int count_per_char() {
   int c, blanks = 0;
   while ((c = getchar()) != EOF) {
     if (isblank(c)) {
@@ -9,4 +13,18 @@ int main() {
     }
   }
   printf("There are %d blanks.\n", blanks);
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc > 1 && strcmp(argv[1], "-c") == 0) {
+    return count_per_char();
+  }
+  countblanks count;
+  FILE *discard = fopen("/dev/null", "w");
+  if (runfilters(0, discard, std::vector<filter *>{&count}) < 0) {
+    return 1;
+  }
+  printf("There are %ld blanks.\n", count.blanks);
+  return 0;
 }
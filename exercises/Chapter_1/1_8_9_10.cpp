@@ -0,0 +1,33 @@
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "filters.h"
+
+/*
+  Chains the filters from 1-8, 1-9 and 1-10 over one pass of stdin, in the order named:
+    ./a.out count squeeze escape < input
+  prints the input with blanks squeezed and specials escaped, then the count of blanks on stderr.
+*/
+int main(int argc, char *argv[]) {
+  countblanks count;
+  squeezeblanks squeeze;
+  escapespecials escape;
+  std::vector<filter *> filters;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "count") == 0) {
+      filters.push_back(&count);
+    } else if (strcmp(argv[i], "squeeze") == 0) {
+      filters.push_back(&squeeze);
+    } else if (strcmp(argv[i], "escape") == 0) {
+      filters.push_back(&escape);
+    } else {
+      fprintf(stderr, "usage: %s [count|squeeze|escape]... < input\n", argv[0]);
+      return 1;
+    }
+  }
+  if (runfilters(0, stdout, filters) < 0) {
+    return 1;
+  }
+  fprintf(stderr, "There are %ld blanks.\n", count.blanks);
+  return 0;
+}
@@ -1,7 +1,11 @@
 #include <stdio.h>
 #include <ctype.h>
+#include <string.h>
+#include <vector>
+#include "filters.h"
 
-int main() {
+// The original loop, one getchar() per character; run it with -c to compare.
+int squeeze_per_char() {
   int c;
   bool blank_section = false;
   while ((c = getchar()) != EOF) {
@@ -19,4 +23,13 @@ int main() {
     blank_section = false;
     putchar(' ');
   }
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc > 1 && strcmp(argv[1], "-c") == 0) {
+    return squeeze_per_char();
+  }
+  squeezeblanks squeeze;
+  return runfilters(0, stdout, std::vector<filter *>{&squeeze}) < 0 ? 1 : 0;
 }
@@ -1,18 +1,11 @@
+#include <limits.h>
 #include <stdio.h>
+#include "formatint.h"
 #define MAXPRINTBUFF 100
 
-char *nextchar(int n, char *s) {
-  if (n < 0) {
-    *s = '-';
-    return nextchar(-n, s + 1);
-  }
-  char *result = n / 10 ? nextchar(n / 10, s) : s;
-  *(result++) = n % 10 + '0';
-  return result;
-}
-
+// Formats without recursing once per digit; see formatint.h.
 void itoa(int n, char s[]) {
-  *nextchar(n, s) = '\0';
+  *formatint(n, s) = '\0';
 }
 
 int main() {
@@ -23,5 +16,6 @@ int main() {
   printf("%s\n", printbuf);
   itoa(0xff, printbuf);
   printf("%s\n", printbuf);
+  itoa(INT_MIN, printbuf);
+  printf("%s\n", printbuf);
 }
-
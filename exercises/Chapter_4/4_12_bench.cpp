@@ -0,0 +1,99 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include "fnv.h"
+#include "formatint.h"
+
+// The recursive itoa this replaces, one call per digit. It never returns for INT_MIN.
+char *nextchar(int n, char *s) {
+  if (n < 0) {
+    *s = '-';
+    return nextchar(-n, s + 1);
+  }
+  char *result = n / 10 ? nextchar(n / 10, s) : s;
+  *(result++) = n % 10 + '0';
+  return result;
+}
+
+// Random bits shifted down a random amount, so every length of number turns up about as often.
+uint64_t randombits(uint64_t *state) {
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state >> (*state % 64);
+}
+
+/*
+  Formats millions of integers, one per line, into one buffer and reports how fast, then the
+  bytes written and their hash.
+    ./a.out recursive  the recursive itoa from 4_12, int32 only
+    ./a.out snprintf   snprintf one at a time
+    ./a.out format     formatint one at a time
+    ./a.out batch      formatints32 or formatints64 over the whole array
+  -l formats int64_t values rather than int32_t, and a number sets how many millions (default 10).
+*/
+int main(int argc, char *argv[]) {
+  const char *mode = NULL;
+  bool wide = false;
+  size_t count = 10000000;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-l") == 0) {
+      wide = true;
+    } else if (argv[i][0] >= '0' && argv[i][0] <= '9') {
+      count = atof(argv[i]) * 1000000;
+    } else {
+      mode = argv[i];
+    }
+  }
+  if (mode == NULL || (wide && strcmp(mode, "recursive") == 0)) {
+    fprintf(stderr, "usage: %s recursive|snprintf|format|batch [-l] [millions]\n", argv[0]);
+    return 1;
+  }
+
+  std::vector<int32_t> narrow(wide ? 0 : count);
+  std::vector<int64_t> values(wide ? count : 0);
+  uint64_t state = 4012;
+  for (size_t i = 0; i < count; i++) {
+    uint64_t bits = randombits(&state);
+    if (wide) {
+      values[i] = (int64_t) bits;
+    } else {
+      // INT_MIN would send the recursive version round forever.
+      narrow[i] = (int32_t) bits == INT32_MIN ? 0 : (int32_t) bits;
+    }
+  }
+  std::vector<char> out(count * (INT64CHARS + 1));
+  char *p = out.data();
+
+  auto start{std::chrono::steady_clock::now()};
+  if (strcmp(mode, "recursive") == 0) {
+    for (size_t i = 0; i < count; i++) {
+      p = nextchar(narrow[i], p);
+      *p++ = '\n';
+    }
+  } else if (strcmp(mode, "snprintf") == 0) {
+    for (size_t i = 0; i < count; i++) {
+      // Room for the longest number, its newline and snprintf's terminator
+      p += wide ? snprintf(p, INT64CHARS + 2, "%lld\n", (long long) values[i]) : snprintf(p, INT32CHARS + 2, "%d\n", narrow[i]);
+    }
+  } else if (strcmp(mode, "format") == 0) {
+    for (size_t i = 0; i < count; i++) {
+      p = formatint(wide ? values[i] : narrow[i], p);
+      *p++ = '\n';
+    }
+  } else if (strcmp(mode, "batch") == 0) {
+    p += wide ? formatints64(values.data(), count, p, '\n') : formatints32(narrow.data(), count, p, '\n');
+  } else {
+    fprintf(stderr, "error: unknown mode %s\n", mode);
+    return 1;
+  }
+  auto finish{std::chrono::steady_clock::now()};
+
+  double seconds = std::chrono::duration<double>{finish - start}.count();
+  size_t len = p - out.data();
+  printf("%s: %zu bytes, %016lx, %.1f M/s\n", mode, len, fnv1a(out.data(), len), count / seconds / 1e6);
+  return 0;
+}
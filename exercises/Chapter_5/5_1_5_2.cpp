@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "getfloat.h"
+#include "getint.h"
+#include "mappedlines.h"
+#include "parsenumbers.h"
+
+// Values parsed per call, so a huge input doesn't need one huge array
+#define BATCH 4096
+
+/*
+  Parses stdin as numbers in bulk and prints them, or with -q just times the parse.
+    ./a.out ints|doubles [-q] [-c] [-v] < input
+  -c times the per-call getint or getfloat instead, and -v checks every double against strtod.
+  A token that doesn't parse is reported by its offset and skipped, like getint skips it.
+*/
+int main(int argc, char *argv[]) {
+  bool doubles = argc > 1 && strcmp(argv[1], "doubles") == 0, quiet = false, percall = false, verify = false;
+  if (argc < 2 || (!doubles && strcmp(argv[1], "ints") != 0)) {
+    fprintf(stderr, "usage: %s ints|doubles [-q] [-c] [-v] < input\n", argv[0]);
+    return 1;
+  }
+  for (int i = 2; i < argc; i++) {
+    quiet = quiet || strcmp(argv[i], "-q") == 0;
+    percall = percall || strcmp(argv[i], "-c") == 0;
+    verify = verify || strcmp(argv[i], "-v") == 0;
+  }
+
+  size_t count = 0, mismatches = 0;
+  double sum = 0;
+  auto start{std::chrono::steady_clock::now()};
+  if (percall) {
+    int c, n;
+    float f;
+    while ((c = doubles ? getfloat(&f) : getint(&n)) != EOF) {
+      if (c == 0) {
+        continue;
+      }
+      count++;
+      sum += doubles ? f : n;
+      if (!quiet) {
+        doubles ? printf("%f\n", f) : printf("%d\n", n);
+      }
+    }
+  } else {
+    struct input in;
+    if (readinput(0, &in) < 0) {
+      fprintf(stderr, "error: could not read input\n");
+      return 1;
+    }
+    std::vector<int64_t> ints(BATCH);
+    std::vector<double> reals(BATCH);
+    struct parseerror error;
+    size_t offset = 0, n;
+    while (offset < in.len) {
+      if (doubles) {
+        n = parsedoubles(in.data + offset, in.len - offset, reals.data(), BATCH, &error);
+      } else {
+        n = parseints(in.data + offset, in.len - offset, ints.data(), BATCH, &error);
+      }
+      for (size_t i = 0; i < n; i++) {
+        sum += doubles ? reals[i] : ints[i];
+        if (!quiet) {
+          doubles ? printf("%.17g\n", reals[i]) : printf("%lld\n", (long long) ints[i]);
+        }
+      }
+      count += n;
+      if (verify && doubles) {
+        // Parse the same stretch again with strtod, which always rounds correctly.
+        std::string parsed(in.data + offset, error.offset);
+        char *p = &parsed[0];
+        for (size_t i = 0; i < n; i++) {
+          double expected = strtod(p, &p);
+          mismatches += memcmp(&expected, &reals[i], sizeof(double)) != 0;
+        }
+      }
+      offset += error.offset;
+      if (error.reason != NULL) {
+        printf("offset %zu: %s\n", offset, error.reason);
+        while (offset < in.len && !strchr(" \n\t\r\v\f", in.data[offset])) {
+          offset++;
+        }
+      }
+    }
+    freeinput(&in);
+  }
+  auto end{std::chrono::steady_clock::now()};
+  double seconds = std::chrono::duration<double>{end - start}.count();
+  fprintf(stderr, "%s%s: %zu values, sum %g, %.1f M values/s\n", percall ? (doubles ? "getfloat" : "getint") : (doubles ? "parsedoubles" : "parseints"),
+    verify ? (mismatches == 0 ? ", all match strtod" : ", MISMATCHES against strtod") : "", count, sum, count / seconds / 1e6);
+  return mismatches == 0 ? 0 : 1;
+}
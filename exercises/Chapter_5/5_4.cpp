@@ -10,17 +10,14 @@ bool streq(char *s, char *t) {
   return *(t + n) == '\0';
 }
 
+// t can only end s at one place, so measure both and compare there once.
 bool strend(char *s, char *t) {
-  if (*t == '\0') {
-    return true;
-  }
-  int n;
-  for (n = 0; *(s + n) != '\0'; n++) {
-    if (streq(s + n, t)) {
-      return true;
-    }
-  }
-  return false;
+  int ls, lt;
+  for (ls = 0; *(s + ls) != '\0'; ls++)
+    ;
+  for (lt = 0; *(t + lt) != '\0'; lt++)
+    ;
+  return lt <= ls && streq(s + ls - lt, t);
 }
 
 void teststrend(char *s, char *t) {
@@ -0,0 +1,145 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <chrono>
+#include <string_view>
+#include <vector>
+#include "mappedlines.h"
+#include "search.h"
+
+// The quadratic scans this replaces, for -n: every offset compared in full, every pattern in turn
+size_t naivefind(std::string_view haystack, std::string_view needle) {
+  for (size_t i = 0; i + needle.size() <= haystack.size(); i++) {
+    size_t j = 0;
+    while (j < needle.size() && haystack[i + j] == needle[j]) {
+      j++;
+    }
+    if (j == needle.size()) {
+      return i;
+    }
+  }
+  return NOTFOUND;
+}
+
+bool naiveendswith(std::string_view s, std::string_view t) {
+  for (size_t i = 0; i <= s.size(); i++) {
+    if (s.substr(i) == t) {
+      return true;
+    }
+  }
+  return false;
+}
+
+enum mode { CONTAINS, ENDSWITH, ANYOF };
+
+/*
+  Prints the lines of stdin that match, like grep.
+    ./a.out pattern      lines containing pattern
+    ./a.out -s suffix    lines ending in suffix
+    ./a.out -f file      lines containing any of the lines in file
+  -c prints how many lines matched and how fast instead, and -n uses the naive scans.
+*/
+int main(int argc, char *argv[]) {
+  bool count = false, naive = false;
+  enum mode mode = CONTAINS;
+  const char *pattern = NULL;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-c") == 0) {
+      count = true;
+    } else if (strcmp(argv[i], "-n") == 0) {
+      naive = true;
+    } else if ((strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "-f") == 0) && i + 1 < argc) {
+      mode = argv[i][1] == 's' ? ENDSWITH : ANYOF;
+      pattern = argv[++i];
+    } else {
+      pattern = argv[i];
+    }
+  }
+  if (pattern == NULL) {
+    fprintf(stderr, "usage: %s [-c] [-n] pattern | -s suffix | -f patternfile < input\n", argv[0]);
+    return 1;
+  }
+
+  struct input patternfile = {NULL, 0, false};
+  std::vector<std::string_view> patterns;
+  struct automaton a;
+  if (mode == ANYOF) {
+    int fd = open(pattern, O_RDONLY);
+    if (fd < 0 || readinput(fd, &patternfile) < 0) {
+      fprintf(stderr, "error: could not read %s\n", pattern);
+      return 1;
+    }
+    close(fd);
+    readlines(patternfile.data, patternfile.data + patternfile.len, patterns, SIZE_MAX);
+    buildautomaton(&a, patterns);
+  }
+  struct input in;
+  if (readinput(0, &in) < 0) {
+    fprintf(stderr, "error: could not read input\n");
+    return 1;
+  }
+
+  auto start{std::chrono::steady_clock::now()};
+  const char *p = in.data, *end = in.data + in.len;
+  std::string_view line, text(in.data, in.len);
+  size_t matched = 0;
+  if (mode == ENDSWITH || naive) {
+    // Line by line
+    while (p < end) {
+      p = nextline(p, end, &line);
+      bool found = false;
+      if (mode == ENDSWITH) {
+        found = naive ? naiveendswith(line, pattern) : ends_with(line, pattern);
+      } else if (mode == CONTAINS) {
+        found = naivefind(line, pattern) != NOTFOUND;
+      } else {
+        for (size_t i = 0; i < patterns.size() && !found; i++) {
+          found = !patterns[i].empty() && naivefind(line, patterns[i]) != NOTFOUND;
+        }
+      }
+      if (found) {
+        matched++;
+        if (!count) {
+          printf("%.*s\n", (int) line.size(), line.data());
+        }
+      }
+    }
+  } else {
+    // Search the whole input at once and only look for line breaks around the matches.
+    size_t offset = 0, at;
+    int which;
+    while (offset < text.size()) {
+      if (mode == CONTAINS) {
+        at = find(text.substr(offset), pattern);
+      } else {
+        at = findany(&a, text.substr(offset), &which);
+      }
+      if (at == NOTFOUND) {
+        break;
+      }
+      at += offset;
+      const char *linestart = in.data + at;
+      while (linestart > in.data && linestart[-1] != '\n') {
+        linestart--;
+      }
+      // Patterns hold no newlines, so a match never spans two lines.
+      const char *next = nextline(linestart, end, &line);
+      matched++;
+      if (!count) {
+        printf("%.*s\n", (int) line.size(), line.data());
+      }
+      offset = next - in.data;
+    }
+  }
+  auto finish{std::chrono::steady_clock::now()};
+  if (count) {
+    double seconds = std::chrono::duration<double>{finish - start}.count();
+    printf("%zu lines matched, %.0f MB/s\n", matched, in.len / seconds / 1e6);
+  }
+  freeinput(&in);
+  if (mode == ANYOF) {
+    freeinput(&patternfile);
+  }
+  return matched > 0 ? 0 : 1;
+}
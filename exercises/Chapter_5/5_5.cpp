@@ -1,35 +1,42 @@
 #include <iostream>
 
-void strncpy(char *, char *, int);
-void strncat(char *, char *, int);
+char *strncpy(char *, char *, int);
+char *strncat(char *, char *, int);
 
-void strncpy(char *target, char *source, int n) {
+// Both return the new terminator, so the next strncat can start there instead of scanning.
+char *strncpy(char *target, char *source, int n) {
   int cursor = 0;
   while (cursor++ < n && (*target++ = *source++) != '\0') {}
+  if (cursor <= n) {
+    // The terminator was copied, so step back onto it.
+    target--;
+  }
   *target = '\0';
+  return target;
 }
 
-void strncat(char *target, char *source, int n) {
-  int cursor = 0;
-  while (*target++ != '\0') {}
-  target--;
-  while (cursor++ < n && (*target++ = *source++) != '\0') {}
-  *target = '\0';
+char *strncat(char *target, char *source, int n) {
+  while (*target != '\0') {
+    target++;
+  }
+  return strncpy(target, source, n);
 }
 
 
 int main() {
-  char *s = new char[101], source[] = "This is the text to copy from.", *t;
+  char source[] = "This is the text to copy from.", *t, *end;
+  // Everything copied comes from source, so its size bounds s.
+  char s[sizeof(source)];
   t = source;
-  strncpy(s, t, 0);
+  end = strncpy(s, t, 0);
   std::cout << s << std::endl;
-  strncpy(s, t, 3);
+  end = strncpy(s, t, 3);
   std::cout << s << std::endl;
-  strncat(s, t+3, 3);
+  end = strncat(end, t+3, 3);
   std::cout << s << std::endl;
-  strncat(s, t+6, 10);
+  end = strncat(end, t+6, 10);
   std::cout << s << std::endl;
-  strncpy(s, t, 100);
+  end = strncpy(s, t, 100);
   std::cout << s << std::endl;
   return 0;
 }
\ No newline at end of file
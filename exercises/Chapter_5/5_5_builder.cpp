@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include "fnv.h"
+#include "mappedlines.h"
+#include "strbuilder.h"
+
+#define NFRAGMENTS 4096
+
+// The strncat from 5_5, which walks the whole target to find its end on every call
+char *rescanncat(char *target, const char *source, int n) {
+  while (*target != '\0') {
+    target++;
+  }
+  int cursor = 0;
+  while (cursor++ < n && (*target++ = *source++) != '\0') {}
+  if (cursor <= n) {
+    target--;
+  }
+  *target = '\0';
+  return target;
+}
+
+/*
+  Builds a string of the given size in MB from 1 to 16 character fragments of stdin and
+  reports how fast, then its length and hash.
+    ./a.out rescan   the strncat from 5_5 into a buffer allocated up front
+    ./a.out end      strncat from the end the last call returned, also allocated up front
+    ./a.out builder  a contiguous strbuilder
+    ./a.out rope     a rope strbuilder, flattened at the end
+    ./a.out string   std::string::append
+*/
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s rescan|end|builder|rope|string [megabytes] < input\n", argv[0]);
+    return 1;
+  }
+  const char *mode = argv[1];
+  size_t size = (size_t) (argc > 2 ? atof(argv[2]) : 100) << 20;
+  struct input in;
+  if (readinput(0, &in) < 0 || in.len < 16) {
+    fprintf(stderr, "error: could not read input\n");
+    return 1;
+  }
+  // Terminated copies of the fragments, so strncat stops at n or at the end of one.
+  static char fragments[NFRAGMENTS][17];
+  static int lengths[NFRAGMENTS];
+  srand(55);
+  for (int i = 0; i < NFRAGMENTS; i++) {
+    lengths[i] = 1 + rand() % 16;
+    memcpy(fragments[i], in.data + rand() % (in.len - 16), lengths[i]);
+    fragments[i][lengths[i]] = '\0';
+  }
+
+  auto start{std::chrono::steady_clock::now()};
+  const char *result;
+  size_t len = 0;
+  char *buffer = NULL;
+  struct strbuilder b;
+  bool usedbuilder = false;
+  std::string s;
+  int i = 0;
+  if (strcmp(mode, "rescan") == 0 || strcmp(mode, "end") == 0) {
+    // The fragments are at most 16 characters, so this holds whatever crosses size.
+    buffer = (char *) malloc(size + 17);
+    buffer[0] = '\0';
+    char *end = buffer;
+    bool rescan = mode[0] == 'r';
+    for (; len < size; i = (i + 1) % NFRAGMENTS) {
+      end = rescan ? rescanncat(buffer, fragments[i], 16) : rescanncat(end, fragments[i], 16);
+      len = end - buffer;
+    }
+    result = buffer;
+  } else if (strcmp(mode, "builder") == 0 || strcmp(mode, "rope") == 0) {
+    initbuilder(&b, mode[0] == 'r');
+    usedbuilder = true;
+    for (; builderlength(&b) < size; i = (i + 1) % NFRAGMENTS) {
+      builderncat(&b, fragments[i], 16);
+    }
+    result = flatten(&b);
+    len = b.len;
+  } else if (strcmp(mode, "string") == 0) {
+    for (; s.size() < size; i = (i + 1) % NFRAGMENTS) {
+      s.append(fragments[i], lengths[i]);
+    }
+    result = s.c_str();
+    len = s.size();
+  } else {
+    fprintf(stderr, "error: unknown mode %s\n", mode);
+    return 1;
+  }
+  auto finish{std::chrono::steady_clock::now()};
+
+  double seconds = std::chrono::duration<double>{finish - start}.count();
+  printf("%s: %zu bytes, %016lx, %.1f MB/s\n", mode, len, fnv1a(result, len), len / seconds / 1e6);
+  free(buffer);
+  if (usedbuilder) {
+    freebuilder(&b);
+  }
+  freeinput(&in);
+  return 0;
+}
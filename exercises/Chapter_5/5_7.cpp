@@ -32,7 +32,7 @@ int main() {
   auto start{std::chrono::steady_clock::now()};
   if ((nlines = readlines(lineptr, linearr, MAXLINES)) >= 0) {
     auto end{std::chrono::steady_clock::now()};
-    printf("This took %fms\n", std::chrono::duration<double>{end - start} * 1000);
+    printf("This took %fms\n", std::chrono::duration<double>{end - start}.count() * 1000);
   } else {
     printf("error: input too big to sort\n");
     return 1;
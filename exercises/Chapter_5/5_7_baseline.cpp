@@ -35,7 +35,7 @@ int main() {
   int nlines;
   if ((nlines = readlines_old(lineptr, MAXLINES)) >= 0) {
     auto end{std::chrono::steady_clock::now()};
-    printf("This took %fms\n", std::chrono::duration<double>{end - start} * 1000);
+    printf("This took %fms\n", std::chrono::duration<double>{end - start}.count() * 1000);
   } else {
     printf("error: input too big to sort\n");
     return 1;
@@ -0,0 +1,23 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <chrono>
+#include <string_view>
+#include <vector>
+#include "mappedlines.h"
+
+int main() {
+  struct input in;
+  std::vector<std::string_view> lines;
+  printf("About to use mapped readlines.\n");
+  auto start{std::chrono::steady_clock::now()};
+  if (readinput(0, &in) < 0) {
+    printf("error: could not read input\n");
+    return 1;
+  }
+  readlines(in.data, in.data + in.len, lines, SIZE_MAX);
+  auto end{std::chrono::steady_clock::now()};
+  printf("Read %zu lines from %zu bytes %s.\n", lines.size(), in.len, in.mapped ? "mapped" : "in chunks");
+  printf("This took %fms\n", std::chrono::duration<double>{end - start}.count() * 1000);
+  freeinput(&in);
+  return 0;
+}
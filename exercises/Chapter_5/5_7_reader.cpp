@@ -0,0 +1,49 @@
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include "getch.h"
+#include "getline.h"
+
+#define MAXLEN 1000
+
+// getline as it was before it read through a buffered reader, one getchar() per byte
+int getline_getchar(char s[], int lim) {
+  int c, i;
+  for (i = 0; i < lim - 1 && (c=getchar()) != EOF && c != '\n'; i++) {
+    s[i] = c;
+  }
+  if (c == '\n') {
+    s[i] = '\n';
+    i++;
+  }
+  s[i] = '\0';
+  return i;
+}
+
+// Reads all of stdin with the named method and prints how fast it went.
+int main(int argc, char *argv[]) {
+  char line[MAXLEN];
+  long bytes = 0, len;
+  const char *method = argc > 1 ? argv[1] : "getline";
+  auto start{std::chrono::steady_clock::now()};
+  if (strcmp(method, "getchar") == 0) {
+    while ((len = getline_getchar(line, MAXLEN)) > 0) {
+      bytes += len;
+    }
+  } else if (strcmp(method, "getline") == 0) {
+    while ((len = getline(line, MAXLEN)) > 0) {
+      bytes += len;
+    }
+  } else if (strcmp(method, "getch") == 0) {
+    while (getch() != EOF) {
+      bytes++;
+    }
+  } else {
+    printf("usage: %s getchar|getline|getch < input\n", argv[0]);
+    return 1;
+  }
+  auto end{std::chrono::steady_clock::now()};
+  double seconds = std::chrono::duration<double>{end - start}.count();
+  printf("%-8s read %ld bytes at %.1f MB/s\n", method, bytes, bytes / seconds / 1e6);
+  return 0;
+}
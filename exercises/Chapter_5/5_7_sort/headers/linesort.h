@@ -0,0 +1,26 @@
+#ifndef LINESORT
+#define LINESORT
+#include <stdio.h>
+#include <string_view>
+#include <vector>
+
+// Sorts lines bytewise, in the order strcmp would put them, on up to nthreads threads.
+void sortlines(std::vector<std::string_view> &lines, unsigned nthreads);
+
+int writelines(const std::vector<std::string_view> &lines, FILE *out);
+
+/*
+  Sorts the lines in [p, end) onto out. Only maxlines lines are indexed at a time: when there
+  are more, each batch is sorted and spilled to a temporary file, and the files are merged
+  at the end. Returns -1 if a temporary file can't be written.
+*/
+int sortinput(const char *p, const char *end, FILE *out, size_t maxlines, unsigned nthreads);
+
+/*
+  The same for input that can't be mapped, such as a pipe: it is read at most maxbytes at a
+  time, so only one batch of it is ever in memory, and batches are spilled and merged the same
+  way. Returns -1 if the input can't be read or a temporary file can't be written.
+*/
+int sortstream(int fd, FILE *out, size_t maxlines, size_t maxbytes, unsigned nthreads);
+
+#endif
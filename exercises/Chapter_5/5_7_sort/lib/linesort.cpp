@@ -0,0 +1,257 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <queue>
+#include <thread>
+#include "linesort.h"
+#include "mappedlines.h"
+
+// Below this many lines starting threads costs more than it saves.
+#define PARALLELMIN (1 << 16)
+// sortstream's buffer starts this big and doubles up to its limit.
+#define STREAMCHUNK (1 << 20)
+
+/*
+  The first 8 bytes of the line, most significant first, so most comparisons are one integer
+  compare that never touches the line itself. Short lines are padded with zeros; the full
+  compare on equal prefixes sorts out "ab" against "ab\0".
+*/
+struct sortkey {
+  uint64_t prefix;
+  std::string_view line;
+};
+
+static uint64_t prefixof(std::string_view line) {
+  uint64_t prefix = 0;
+  for (size_t i = 0; i < 8 && i < line.size(); i++) {
+    prefix |= (uint64_t) (unsigned char) line[i] << (56 - 8 * i);
+  }
+  return prefix;
+}
+
+// string_view compares bytes as unsigned char, like strcmp.
+static bool before(const sortkey &a, const sortkey &b) {
+  if (a.prefix != b.prefix) {
+    return a.prefix < b.prefix;
+  }
+  return a.line < b.line;
+}
+
+// Sorts nthreads slices at once, then merges neighbouring slices in pairs until one is left.
+static void sortkeys(std::vector<sortkey> &keys, unsigned nthreads) {
+  if (nthreads <= 1 || keys.size() < PARALLELMIN) {
+    std::sort(keys.begin(), keys.end(), before);
+    return;
+  }
+  std::vector<size_t> bounds;
+  for (unsigned i = 0; i <= nthreads; i++) {
+    bounds.push_back(keys.size() * i / nthreads);
+  }
+  std::vector<std::thread> workers;
+  for (unsigned i = 0; i < nthreads; i++) {
+    workers.emplace_back([&keys, &bounds, i]() {
+      std::sort(keys.begin() + bounds[i], keys.begin() + bounds[i + 1], before);
+    });
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+
+  std::vector<sortkey> merged(keys.size());
+  while (bounds.size() > 2) {
+    std::vector<size_t> next;
+    workers.clear();
+    for (size_t i = 0; i + 1 < bounds.size(); i += 2) {
+      next.push_back(bounds[i]);
+      if (i + 2 < bounds.size()) {
+        workers.emplace_back([&keys, &merged, &bounds, i]() {
+          std::merge(keys.begin() + bounds[i], keys.begin() + bounds[i + 1],
+            keys.begin() + bounds[i + 1], keys.begin() + bounds[i + 2],
+            merged.begin() + bounds[i], before);
+        });
+      } else {
+        // An odd slice out waits for the next round.
+        std::copy(keys.begin() + bounds[i], keys.begin() + bounds[i + 1], merged.begin() + bounds[i]);
+      }
+    }
+    next.push_back(keys.size());
+    for (std::thread &worker : workers) {
+      worker.join();
+    }
+    keys.swap(merged);
+    bounds.swap(next);
+  }
+}
+
+void sortlines(std::vector<std::string_view> &lines, unsigned nthreads) {
+  std::vector<sortkey> keys;
+  keys.reserve(lines.size());
+  for (std::string_view line : lines) {
+    keys.push_back({prefixof(line), line});
+  }
+  sortkeys(keys, nthreads);
+  for (size_t i = 0; i < keys.size(); i++) {
+    lines[i] = keys[i].line;
+  }
+}
+
+int writelines(const std::vector<std::string_view> &lines, FILE *out) {
+  for (std::string_view line : lines) {
+    if (fwrite(line.data(), 1, line.size(), out) != line.size() || putc('\n', out) == EOF) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+struct runhead {
+  sortkey key;
+  size_t run;
+};
+
+static bool after(const runhead &a, const runhead &b) {
+  return before(b.key, a.key);
+}
+
+// Merges the sorted runs onto out, smallest head first.
+static int mergeruns(std::vector<FILE *> &runs, FILE *out) {
+  std::vector<struct input> inputs(runs.size());
+  std::vector<const char *> positions(runs.size());
+  std::priority_queue<runhead, std::vector<runhead>, decltype(&after)> heads(after);
+  std::string_view line;
+  int result = 0;
+
+  for (size_t i = 0; i < runs.size(); i++) {
+    if (fflush(runs[i]) == EOF || readinput(fileno(runs[i]), &inputs[i]) < 0) {
+      result = -1;
+      continue;
+    }
+    positions[i] = nextline(inputs[i].data, inputs[i].data + inputs[i].len, &line);
+    heads.push({{prefixof(line), line}, i});
+  }
+  while (result == 0 && !heads.empty()) {
+    runhead head = heads.top();
+    heads.pop();
+    if (fwrite(head.key.line.data(), 1, head.key.line.size(), out) != head.key.line.size() || putc('\n', out) == EOF) {
+      result = -1;
+    }
+    const char *end = inputs[head.run].data + inputs[head.run].len;
+    if (positions[head.run] < end) {
+      positions[head.run] = nextline(positions[head.run], end, &line);
+      heads.push({{prefixof(line), line}, head.run});
+    }
+  }
+  for (size_t i = 0; i < runs.size(); i++) {
+    freeinput(&inputs[i]);
+    fclose(runs[i]);
+  }
+  return result;
+}
+
+// Writes sorted lines to a new temporary file at the end of runs.
+static int spill(const std::vector<std::string_view> &lines, std::vector<FILE *> &runs) {
+  FILE *run = tmpfile();
+  if (run == NULL || writelines(lines, run) < 0) {
+    if (run != NULL) {
+      fclose(run);
+    }
+    return -1;
+  }
+  runs.push_back(run);
+  return 0;
+}
+
+static int closeruns(std::vector<FILE *> &runs) {
+  for (FILE *run : runs) {
+    fclose(run);
+  }
+  return -1;
+}
+
+int sortinput(const char *p, const char *end, FILE *out, size_t maxlines, unsigned nthreads) {
+  std::vector<std::string_view> lines;
+  std::vector<FILE *> runs;
+  p = readlines(p, end, lines, maxlines);
+  while (true) {
+    sortlines(lines, nthreads);
+    if (p == end && runs.empty()) {
+      return writelines(lines, out);
+    }
+    if (spill(lines, runs) < 0) {
+      return closeruns(runs);
+    }
+    if (p == end) {
+      return mergeruns(runs, out);
+    }
+    lines.clear();
+    p = readlines(p, end, lines, maxlines);
+  }
+}
+
+int sortstream(int fd, FILE *out, size_t maxlines, size_t maxbytes, unsigned nthreads) {
+  std::vector<std::string_view> lines;
+  std::vector<FILE *> runs;
+  size_t capacity = std::min((size_t) STREAMCHUNK, std::max((size_t) 1, maxbytes)), len = 0;
+  char *buf = (char *) malloc(capacity);
+  bool eof = false;
+  int result = 0;
+  while (buf != NULL && result == 0) {
+    while (!eof && len < capacity) {
+      ssize_t n = read(fd, buf + len, capacity - len);
+      if (n < 0) {
+        result = -1;
+        break;
+      }
+      eof = n == 0;
+      len += n;
+    }
+    // Only whole lines are sorted; a partial last line waits for the rest of it.
+    const char *end = buf + len;
+    if (!eof) {
+      const char *nl = (const char *) memrchr(buf, '\n', len);
+      end = nl == NULL ? NULL : nl + 1;
+    }
+    if (result == 0 && !eof && (capacity < maxbytes || end == NULL)) {
+      // Grow up to maxbytes, or past it for a single line longer than that.
+      capacity *= 2;
+      char *grown = (char *) realloc(buf, capacity);
+      if (grown == NULL) {
+        // buf is still ours; it's freed below along with the runs.
+        result = -1;
+        break;
+      }
+      buf = grown;
+      continue;
+    }
+    if (result < 0) {
+      break;
+    }
+
+    lines.clear();
+    const char *stop = readlines(buf, end, lines, maxlines);
+    sortlines(lines, nthreads);
+    bool last = eof && stop == buf + len;
+    if (last && runs.empty()) {
+      result = writelines(lines, out);
+      break;
+    }
+    if (!lines.empty() && spill(lines, runs) < 0) {
+      result = -1;
+      break;
+    }
+    if (last) {
+      free(buf);
+      return mergeruns(runs, out);
+    }
+    // Keep whatever wasn't indexed for the next batch.
+    len -= stop - buf;
+    memmove(buf, stop, len);
+  }
+  free(buf);
+  if (buf == NULL || result < 0) {
+    return closeruns(runs);
+  }
+  return result;
+}
@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include "linesort.h"
+#include "mappedlines.h"
+
+// Bytes of index per line: the view, plus a key and a merge buffer entry while sorting
+#define INDEXBYTES 64
+
+/*
+  Sorts stdin onto stdout. Timings go to stderr. A regular file is mapped; anything else, like
+  a pipe, is read a quarter of memory at a time and spilled the same way as -r.
+    -t n  sort on n threads instead of one per core
+    -r n  index at most n lines at a time, spilling sorted runs to temporary files
+    -b    sort copies of the lines with std::sort and strcmp instead, for comparison
+    -q    sort but don't print the lines
+*/
+int main(int argc, char *argv[]) {
+  unsigned nthreads = std::max(1u, std::thread::hardware_concurrency());
+  // Leave room for the rest of the machine: a quarter of memory for the index by default.
+  size_t memory = (size_t) sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGESIZE);
+  size_t maxlines = memory / 4 / INDEXBYTES;
+  bool baseline = false, quiet = false;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+      nthreads = std::max(1l, strtol(argv[++i], NULL, 10));
+    } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+      maxlines = std::max(1l, strtol(argv[++i], NULL, 10));
+    } else if (strcmp(argv[i], "-b") == 0) {
+      baseline = true;
+    } else if (strcmp(argv[i], "-q") == 0) {
+      quiet = true;
+    } else {
+      fprintf(stderr, "usage: %s [-t threads] [-r lines per run] [-b] [-q] < input\n", argv[0]);
+      return 1;
+    }
+  }
+
+  FILE *out = quiet ? fopen("/dev/null", "w") : stdout;
+  int result = 0;
+  struct stat st;
+  if (!baseline && (fstat(0, &st) != 0 || !S_ISREG(st.st_mode))) {
+    auto start{std::chrono::steady_clock::now()};
+    result = sortstream(0, out, maxlines, memory / 4, nthreads);
+    fflush(out);
+    auto end{std::chrono::steady_clock::now()};
+    if (result < 0) {
+      fprintf(stderr, "error: could not read the input or write a sorted run\n");
+    }
+    fprintf(stderr, "sortstream on %u threads took %fms\n", nthreads, std::chrono::duration<double>{end - start}.count() * 1000);
+    return result < 0 ? 1 : 0;
+  }
+
+  struct input in;
+  if (readinput(0, &in) < 0) {
+    fprintf(stderr, "error: could not read input\n");
+    return 1;
+  }
+
+  if (baseline) {
+    // Copy every line into its own string the way readlines does; only the sort and output are timed.
+    std::vector<std::string_view> lines;
+    readlines(in.data, in.data + in.len, lines, SIZE_MAX);
+    char *strings = (char *) malloc(in.len + lines.size() + 1), *p = strings;
+    std::vector<char *> lineptr;
+    for (std::string_view line : lines) {
+      memcpy(p, line.data(), line.size());
+      p[line.size()] = '\0';
+      lineptr.push_back(p);
+      p += line.size() + 1;
+    }
+    auto start{std::chrono::steady_clock::now()};
+    std::sort(lineptr.begin(), lineptr.end(), [](const char *a, const char *b) { return strcmp(a, b) < 0; });
+    for (char *line : lineptr) {
+      fputs(line, out);
+      putc('\n', out);
+    }
+    fflush(out);
+    auto end{std::chrono::steady_clock::now()};
+    fprintf(stderr, "std::sort with strcmp took %fms for %zu lines\n", std::chrono::duration<double>{end - start}.count() * 1000, lineptr.size());
+    free(strings);
+  } else {
+    auto start{std::chrono::steady_clock::now()};
+    result = sortinput(in.data, in.data + in.len, out, maxlines, nthreads);
+    fflush(out);
+    auto end{std::chrono::steady_clock::now()};
+    if (result < 0) {
+      fprintf(stderr, "error: could not write a sorted run\n");
+    }
+    fprintf(stderr, "sortinput on %u threads took %fms\n", nthreads, std::chrono::duration<double>{end - start}.count() * 1000);
+  }
+  freeinput(&in);
+  return result < 0 ? 1 : 0;
+}
@@ -1,9 +1,5 @@
 #include <stdio.h>
-
-static int daytab[2][13] {
-  {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31},
-  {0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31}
-};
+#include "dates.h"
 
 static const char *month_names[] {
   "", "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
@@ -43,6 +39,11 @@ int main() {
   } else {
     printf("Oops. month_day doesn't validate properly.\n");
   }
+  if (month_day(2024, 0, &month, &day)) {
+    printf("month_day rejects the 0th day of 2024, as expected.\n");
+  } else {
+    printf("Oops. month_day doesn't validate properly.\n");
+  }
 
   if (day_of_year(2024, 13, 1) >= 0) {
     printf("Oops. day_of_year doesn't validate properly.\n");
@@ -51,6 +52,20 @@ int main() {
     printf("day_of_year rejects month = 13 as expected.\n");
   }
 
+  if (day_of_year(2024, 0, 1) >= 0) {
+    printf("Oops. day_of_year doesn't validate properly.\n");
+    return 1;
+  } else {
+    printf("day_of_year rejects month = 0 as expected.\n");
+  }
+
+  if (day_of_year(2024, 3, 0) >= 0) {
+    printf("Oops. day_of_year doesn't validate properly.\n");
+    return 1;
+  } else {
+    printf("day_of_year rejects March 0 as expected.\n");
+  }
+
   if (day_of_year(2024, 2, 30) >= 0) {
     printf("Oops. day_of_year doesn't validate properly.\n");
     return 1;
@@ -64,6 +79,18 @@ int main() {
   } else {
     printf("day_of_year rejects Feb 29, 2023 as expected.\n");
   }
+
+  // The ends of the range daysfromcivil supports
+  int ends[2][3] = {{-1000000, 1, 1}, {1000000, 12, 31}};
+  for (int i = 0; i < 2; i++) {
+    int32_t days = daysfromcivil(ends[i][0], ends[i][1], ends[i][2]), year, month, day;
+    civilfromdays(days, &year, &month, &day);
+    if (year != ends[i][0] || month != ends[i][1] || day != ends[i][2]) {
+      printf("Oops. Day %d converts back to %d-%02d-%02d.\n", days, year, month, day);
+      return 1;
+    }
+    printf("%d-%02d-%02d is day %d since 1970 and converts back.\n", year, month, day, days);
+  }
   return 0;
 }
 
@@ -80,39 +107,12 @@ const char *postfix_for(int x) {
   return "th";
 }
 
-bool is_leap(int year) {
-  return year%4 == 0 && year%100 != 0 || year%400 == 0;
-}
-
+// Both look the month up in dates.h's cumulative table instead of walking the months.
 int day_of_year(int year, int month, int day) {
-  if (month > 12) {
-    return -1;
-  }
-  if (day > daytab[is_leap(year)][month]) {
-    return -1;
-  }
-  int i;
-
-  for (i = 1; i < month; i++) {
-    day += daytab[is_leap(year)][i];
-  }
-  return day;
+  return dayofyear(year, month, day);
 }
 
+// Returns true when there is no such day.
 bool month_day(int year, int yearday, int *pmonth, int *pday) {
-  if (yearday > 366) {
-    return true;
-  }
-  if (yearday == 366 && !is_leap(year)) {
-    return true;
-  }
-  int i;
-  bool leap = is_leap(year);
-
-  for (i = 1; yearday > daytab[leap][i]; i++) {
-    yearday -= daytab[leap][i];
-  }
-  *pmonth = i;
-  *pday = yearday;
-  return false;
+  return !monthday(year, yearday, pmonth, pday);
 }
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include "dates.h"
+
+// The looped versions from 5_8, before dates.h
+static int daytab[2][13] {
+  {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31},
+  {0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31}
+};
+
+bool is_leap(int year) {
+  return (year%4 == 0 && year%100 != 0) || year%400 == 0;
+}
+
+int day_of_year(int year, int month, int day) {
+  if (month > 12) {
+    return -1;
+  }
+  if (day > daytab[is_leap(year)][month]) {
+    return -1;
+  }
+  for (int i = 1; i < month; i++) {
+    day += daytab[is_leap(year)][i];
+  }
+  return day;
+}
+
+bool month_day(int year, int yearday, int *pmonth, int *pday) {
+  if (yearday > 366 || (yearday == 366 && !is_leap(year))) {
+    return true;
+  }
+  int i;
+  bool leap = is_leap(year);
+  for (i = 1; yearday > daytab[leap][i]; i++) {
+    yearday -= daytab[leap][i];
+  }
+  *pmonth = i;
+  *pday = yearday;
+  return false;
+}
+
+/*
+  Converts millions of random dates from 1900 to 2100 and reports how fast, with a checksum.
+    ./a.out looped   day_of_year and back with month_day, walking the months
+    ./a.out table    dayofyear and back with monthday, from the cumulative table
+    ./a.out civil    daysfromcivils and back with civilsfromdays over the whole arrays
+    ./a.out sscanf   YYYY-MM-DD lines read with sscanf, then daysfromcivil
+    ./a.out parse    the same lines read with parseisodates
+  The first two checksums agree, as do the last two. A number sets how many millions (default 10).
+*/
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s looped|table|civil|sscanf|parse [millions]\n", argv[0]);
+    return 1;
+  }
+  const char *mode = argv[1];
+  size_t count = (argc > 2 ? atof(argv[2]) : 10) * 1000000;
+  std::vector<int32_t> years(count), months(count), days(count), numbers(count);
+  srand(58);
+  for (size_t i = 0; i < count; i++) {
+    numbers[i] = daysfromcivil(1900, 1, 1) + rand() % 73049;
+  }
+  civilsfromdays(numbers.data(), count, years.data(), months.data(), days.data());
+  // Room for snprintf's terminator after the last line
+  std::vector<char> text(count * 11 + 1);
+  for (size_t i = 0; i < count; i++) {
+    snprintf(text.data() + i * 11, 12, "%04d-%02d-%02d\n", years[i], months[i], days[i]);
+  }
+
+  long checksum = 0;
+  auto start{std::chrono::steady_clock::now()};
+  if (strcmp(mode, "looped") == 0) {
+    for (size_t i = 0; i < count; i++) {
+      int yearday = day_of_year(years[i], months[i], days[i]), month, day;
+      month_day(years[i], yearday, &month, &day);
+      checksum += yearday + month + day;
+    }
+  } else if (strcmp(mode, "table") == 0) {
+    for (size_t i = 0; i < count; i++) {
+      int yearday = dayofyear(years[i], months[i], days[i]), month, day;
+      monthday(years[i], yearday, &month, &day);
+      checksum += yearday + month + day;
+    }
+  } else if (strcmp(mode, "civil") == 0) {
+    std::vector<int32_t> out(count);
+    daysfromcivils(years.data(), months.data(), days.data(), count, out.data());
+    civilsfromdays(out.data(), count, years.data(), months.data(), days.data());
+    for (size_t i = 0; i < count; i++) {
+      checksum += out[i] + months[i] + days[i];
+    }
+  } else if (strcmp(mode, "sscanf") == 0) {
+    // sscanf measures its whole input first, so give it one terminated line at a time.
+    char line[11] = {};
+    for (size_t i = 0; i < count; i++) {
+      int year, month, day;
+      memcpy(line, text.data() + i * 11, 10);
+      sscanf(line, "%d-%d-%d", &year, &month, &day);
+      checksum += daysfromcivil(year, month, day);
+    }
+  } else if (strcmp(mode, "parse") == 0) {
+    std::vector<int32_t> out(count);
+    struct parseerror error;
+    size_t parsed = parseisodates(text.data(), count * 11, out.data(), count, &error);
+    if (error.reason != NULL) {
+      printf("error at %zu: %s\n", error.offset, error.reason);
+      return 1;
+    }
+    for (size_t i = 0; i < parsed; i++) {
+      checksum += out[i];
+    }
+  } else {
+    fprintf(stderr, "error: unknown mode %s\n", mode);
+    return 1;
+  }
+  auto finish{std::chrono::steady_clock::now()};
+
+  double seconds = std::chrono::duration<double>{finish - start}.count();
+  printf("%s: %ld, %.1f M/s\n", mode, checksum, count / seconds / 1e6);
+  return 0;
+}
@@ -0,0 +1,9 @@
+#ifndef CHARS
+#define CHARS
+
+// isspace without the locale lookup: the C locale's six whitespace characters.
+inline bool isspace_(char c) {
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef DATES
+#define DATES
+#include <stddef.h>
+#include <stdint.h>
+#include "parsenumbers.h"
+
+/*
+  Days before each month, cumulativedays[leap][month] for months 1 to 12, with [13] the days
+  in the whole year. Worked out at compile time from the month lengths.
+*/
+struct cumulativetable {
+  short days[2][14];
+};
+
+constexpr struct cumulativetable makecumulative() {
+  const short lengths[13] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  struct cumulativetable t = {};
+  for (int leap = 0; leap < 2; leap++) {
+    for (int month = 1; month <= 12; month++) {
+      t.days[leap][month + 1] = t.days[leap][month] + lengths[month] + (leap && month == 2);
+    }
+  }
+  return t;
+}
+
+inline constexpr struct cumulativetable cumulativedays = makecumulative();
+
+inline int isleap(int year) {
+  return (year % 4 == 0) & ((year % 100 != 0) | (year % 400 == 0));
+}
+
+// The day of the year, counting January 1 as 1, or -1 if there is no such date.
+inline int dayofyear(int year, int month, int day) {
+  if (month < 1 || month > 12) {
+    return -1;
+  }
+  const short *before = cumulativedays.days[isleap(year)];
+  if (day < 1 || day > before[month + 1] - before[month]) {
+    return -1;
+  }
+  return before[month] + day;
+}
+
+/*
+  The month and day of a day of the year, or false if the year has no such day. (yearday - 1) / 32
+  is the month before or the month itself, so one comparison finishes it.
+*/
+inline bool monthday(int year, int yearday, int *month, int *day) {
+  const short *before = cumulativedays.days[isleap(year)];
+  if (yearday < 1 || yearday > before[13]) {
+    return false;
+  }
+  int m = ((yearday - 1) >> 5) + 1;
+  m += yearday > before[m + 1];
+  *month = m;
+  *day = yearday - before[m];
+  return true;
+}
+
+/*
+  Converts between dates in the proleptic Gregorian calendar and days since 1970-01-01, with
+  Howard Hinnant's arithmetic on 400 year eras and years that start in March, so February's
+  length only matters at the end. Years are shifted up by SHIFTERAS eras so everything stays
+  unsigned, with one era to spare for January and February, which count as the year before:
+  years from -1000000 to 1000000 work. Neither validates the date.
+*/
+#define SHIFTERAS 2501
+#define DAYSPERERA 146097
+// Days from 0000-03-01 to 1970-01-01
+#define EPOCHDAYS 719468
+
+inline int32_t daysfromcivil(int32_t year, int32_t month, int32_t day) {
+  uint32_t y = year - (month <= 2) + SHIFTERAS * 400;
+  uint32_t era = y / 400, yoe = y - era * 400;
+  // Months counted from March, 0 to 11
+  uint32_t mp = (month + 9) % 12;
+  uint32_t doy = (153 * mp + 2) / 5 + day - 1;
+  uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return (int32_t) (era * DAYSPERERA + doe) - (SHIFTERAS * DAYSPERERA + EPOCHDAYS);
+}
+
+inline void civilfromdays(int32_t days, int32_t *year, int32_t *month, int32_t *day) {
+  uint32_t z = days + (SHIFTERAS * DAYSPERERA + EPOCHDAYS);
+  uint32_t era = z / DAYSPERERA, doe = z - era * DAYSPERERA;
+  uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  uint32_t mp = (5 * doy + 2) / 153;
+  uint32_t m = mp + 3 - 12 * (mp >= 10);
+  *day = doy - (153 * mp + 2) / 5 + 1;
+  *month = m;
+  *year = (int32_t) (yoe + era * 400) - SHIFTERAS * 400 + (m <= 2);
+}
+
+/*
+  The same over whole arrays. Years, months and days are separate arrays and the loops have no
+  branches, so the compiler is free to vectorize them.
+*/
+void daysfromcivils(const int32_t *years, const int32_t *months, const int32_t *days, size_t n, int32_t *out);
+void civilsfromdays(const int32_t *in, size_t n, int32_t *years, int32_t *months, int32_t *days);
+
+// Parses the 10 bytes at s as YYYY-MM-DD, returning false unless they are a real date.
+bool parseisodate(const char *s, int32_t *year, int32_t *month, int32_t *day);
+
+/*
+  Parses whitespace separated YYYY-MM-DD dates from the n bytes at p into days since 1970-01-01,
+  stopping after max of them, at the end of the buffer or at the first bad one, like parseints.
+*/
+size_t parseisodates(const char *p, size_t n, int32_t *days, size_t max, struct parseerror *error);
+
+#endif
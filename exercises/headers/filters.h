@@ -0,0 +1,42 @@
+#ifndef FILTERS
+#define FILTERS
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+/*
+  A text filter that works on whole blocks instead of a character at a time. apply appends what
+  a block becomes to out; anything that has to carry over to the next block, like being in
+  the middle of a run of blanks, lives in the filter.
+*/
+struct filter {
+  virtual ~filter() {}
+  virtual void apply(const char *in, size_t n, std::string &out) = 0;
+  // Appends anything still held back once the input has ended.
+  virtual void finish(std::string &) {}
+  // True for filters that only look, so the runner passes their input on as it was.
+  virtual bool observes_only() const { return false; }
+};
+
+// Counts spaces and tabs, like isblank
+struct countblanks : filter {
+  long blanks = 0;
+  void apply(const char *in, size_t n, std::string &out) override;
+  bool observes_only() const override { return true; }
+};
+
+// Replaces each run of spaces and tabs with one space.
+struct squeezeblanks : filter {
+  bool inblank = false;
+  void apply(const char *in, size_t n, std::string &out) override;
+};
+
+// Writes tabs, backspaces and backslashes as \t, \b and \\.
+struct escapespecials : filter {
+  void apply(const char *in, size_t n, std::string &out) override;
+};
+
+// Reads fd to the end, passing each block through the filters in order, and writes what comes out to out.
+int runfilters(int fd, FILE *out, const std::vector<filter *> &filters);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef FNV
+#define FNV
+#include <stddef.h>
+
+// The 64 bit FNV-1a hash of n bytes, for checking that different methods produced the same output.
+unsigned long fnv1a(const char *p, size_t n);
+
+#endif
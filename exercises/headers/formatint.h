@@ -0,0 +1,27 @@
+#ifndef FORMATINT
+#define FORMATINT
+#include <stddef.h>
+#include <stdint.h>
+
+// The longest int32_t and int64_t in decimal, sign included: -2147483648 and -9223372036854775808
+#define INT32CHARS 11
+#define INT64CHARS 20
+
+// The number of decimal digits in v, without a loop.
+int countdigits(uint64_t v);
+
+/*
+  Write n in decimal at s, without a terminator, and return the end. Digits go in two at a time,
+  from the end, out of a table of "00" to "99". Every value is in range, INT64_MIN included.
+*/
+char *formatuint(uint64_t n, char *s);
+char *formatint(int64_t n, char *s);
+
+/*
+  Format count values into out, each followed by separator, and return the bytes written. out
+  needs room for count * (INT32CHARS + 1) or count * (INT64CHARS + 1) bytes.
+*/
+size_t formatints32(const int32_t *values, size_t count, char *out, char separator);
+size_t formatints64(const int64_t *values, size_t count, char *out, char separator);
+
+#endif
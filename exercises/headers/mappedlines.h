@@ -0,0 +1,22 @@
+#ifndef MAPPEDLINES
+#define MAPPEDLINES
+#include <stddef.h>
+#include <string_view>
+#include <vector>
+
+// A whole input, mapped when it is a regular file and read into one buffer otherwise
+struct input {
+  char *data;
+  size_t len;
+  bool mapped;
+};
+
+int readinput(int fd, struct input *in);
+void freeinput(struct input *in);
+
+// Sets *line to the line starting at p, without its newline, and returns where the next one starts.
+const char *nextline(const char *p, const char *end, std::string_view *line);
+// Appends up to maxlines lines from [p, end) and returns where it stopped.
+const char *readlines(const char *p, const char *end, std::vector<std::string_view> &lines, size_t maxlines);
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef PARSENUMBERS
+#define PARSENUMBERS
+#include <stddef.h>
+#include <stdint.h>
+
+// Where a parse stopped and why; reason is NULL when everything parsed.
+struct parseerror {
+  size_t offset;
+  const char *reason;
+};
+
+/*
+  Parse whitespace separated numbers from the n bytes at p into values, stopping after max of
+  them, at the end of the buffer, or at the first token that isn't a number. Each returns how
+  many values it stored; call again from just past error->offset to skip a bad token.
+
+  Integers are an optional sign and decimal digits, and must fit in an int64_t. Floating point
+  numbers may also have a fraction and an exponent, as in -.89 or 6.02e23, and are rounded
+  correctly to the nearest double.
+*/
+size_t parseints(const char *p, size_t n, int64_t *values, size_t max, struct parseerror *error);
+size_t parsedoubles(const char *p, size_t n, double *values, size_t max, struct parseerror *error);
+
+#endif
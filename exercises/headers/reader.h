@@ -0,0 +1,44 @@
+#ifndef READER
+#define READER
+#include <stdio.h>
+
+#define READERBUFSIZE (1 << 16)
+#define PUSHBACKSIZE 64
+
+/*
+  Buffered input from one file descriptor, refilled READERBUFSIZE bytes at a time with read().
+  Each stream gets its own reader, so threads reading different streams share nothing.
+  Characters pushed back with unreadch come out again, last in first out, before the buffer.
+*/
+struct reader {
+  int fd;
+  size_t pos, len;
+  int npushback;
+  int pushback[PUSHBACKSIZE];
+  char buf[READERBUFSIZE];
+};
+
+void initreader(struct reader *r, int fd);
+// Refills the buffer once it is used up; returns the bytes read, 0 at end of input.
+int fillreader(struct reader *r);
+
+inline int readch(struct reader *r) {
+  if (r->npushback > 0) {
+    return r->pushback[--r->npushback];
+  }
+  if (r->pos < r->len || fillreader(r) > 0) {
+    return (unsigned char) r->buf[r->pos++];
+  }
+  return EOF;
+}
+
+// Returns -1, and drops c, when PUSHBACKSIZE characters are already pushed back.
+int unreadch(struct reader *r, int c);
+
+// Like getline: at most lim - 1 characters up to and including a newline, then '\0'.
+int readline(struct reader *r, char s[], int lim);
+
+// The reader getline, getch and ungetch share
+struct reader *stdinreader(void);
+
+#endif
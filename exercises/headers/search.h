@@ -0,0 +1,40 @@
+#ifndef SEARCH
+#define SEARCH
+#include <stddef.h>
+#include <stdint.h>
+#include <string_view>
+#include <vector>
+
+#define NOTFOUND ((size_t) -1)
+
+// Compares t with the one place in s it could end at.
+bool ends_with(std::string_view s, std::string_view t);
+
+/*
+  The offset of the first needle in haystack, or NOTFOUND. Only positions where both the
+  needle's first and last bytes match, found 16 at a time, are compared in full.
+*/
+size_t find(std::string_view haystack, std::string_view needle);
+
+/*
+  An Aho-Corasick automaton that finds any of many patterns in one pass over the text. Bytes
+  that appear in no pattern share one class, so the transition table is states by classes
+  rather than states by 256.
+*/
+struct automaton {
+  int nclasses;
+  unsigned char classof[256];
+  // next[state * nclasses + class]
+  std::vector<int32_t> next;
+  // The pattern ending at each state, itself or through its failure links, or -1
+  std::vector<int32_t> hit;
+  std::vector<size_t> lengths;
+};
+
+// Empty patterns are ignored.
+void buildautomaton(struct automaton *a, const std::vector<std::string_view> &patterns);
+
+// The offset of the earliest ending match in text, or NOTFOUND, setting *pattern to the index of what matched.
+size_t findany(const struct automaton *a, std::string_view text, int *pattern);
+
+#endif
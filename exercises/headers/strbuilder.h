@@ -0,0 +1,41 @@
+#ifndef STRBUILDER
+#define STRBUILDER
+#include <stddef.h>
+#include <stdio.h>
+#include <vector>
+
+// Rope chunks are this size and never move once allocated.
+#define ROPECHUNK (1 << 20)
+
+/*
+  A string that remembers its length, so appending never rescans what is already there. By
+  default it is one terminated buffer that doubles when full. In rope mode it is a list of
+  ROPECHUNK byte chunks instead, so growing never copies what was already appended; flatten
+  joins them once at the end.
+*/
+struct strbuilder {
+  // The contiguous string, or the chunk being filled in rope mode
+  char *data;
+  size_t len, cap;
+  bool rope;
+  // Full chunks, in order, in rope mode
+  std::vector<char *> chunks;
+};
+
+void initbuilder(struct strbuilder *b, bool rope);
+void freebuilder(struct strbuilder *b);
+size_t builderlength(const struct strbuilder *b);
+
+/*
+  Like strncat and strncpy: copy at most n characters of source, stopping at its terminator.
+  Both return the new end of the string, where the terminator is in contiguous mode.
+*/
+char *builderncat(struct strbuilder *b, const char *source, size_t n);
+char *builderncpy(struct strbuilder *b, const char *source, size_t n);
+
+// Joins a rope into one terminated buffer and returns it; the builder is contiguous afterwards.
+char *flatten(struct strbuilder *b);
+// Writes the string without flattening it; returns false if a write failed.
+bool builderwrite(const struct strbuilder *b, FILE *out);
+
+#endif
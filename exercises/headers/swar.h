@@ -0,0 +1,20 @@
+#ifndef SWAR
+#define SWAR
+#include <stdint.h>
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// True when all 8 bytes are '0' to '9': no byte has a high nibble other than 3, even after adding 6.
+inline bool eightdigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+}
+
+// The value of 8 digits, first digit in the lowest byte, combined in pairs, then fours, then all 8.
+inline uint64_t eightvalue(uint64_t chunk) {
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8);
+  return (((chunk & 0x000000FF000000FF) * (100 + (1000000ULL << 32)))
+    + (((chunk >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >> 32;
+}
+#endif
+
+#endif
@@ -0,0 +1,13 @@
+# Sourced by the exercise scripts that time themselves on a large input.
+# bigfile <file> <bytes> copies file to a new temporary file, doubles it until it holds at least
+# that many bytes, cuts it to exactly that many and prints the temporary file's name.
+bigfile() {
+  local big=$(mktemp)
+  cp "$1" $big
+  while [ $(stat -c %s $big) -lt $2 ]; do
+    cat $big $big > $big.next
+    mv $big.next $big
+  done
+  truncate -s $2 $big
+  echo $big
+}
@@ -0,0 +1,75 @@
+#include <string.h>
+#include "chars.h"
+#include "dates.h"
+#include "swar.h"
+
+void daysfromcivils(const int32_t *years, const int32_t *months, const int32_t *days, size_t n, int32_t *out) {
+  for (size_t i = 0; i < n; i++) {
+    out[i] = daysfromcivil(years[i], months[i], days[i]);
+  }
+}
+
+void civilsfromdays(const int32_t *in, size_t n, int32_t *years, int32_t *months, int32_t *days) {
+  for (size_t i = 0; i < n; i++) {
+    civilfromdays(in[i], years + i, months + i, days + i);
+  }
+}
+
+bool parseisodate(const char *s, int32_t *year, int32_t *month, int32_t *day) {
+  if (s[4] != '-' || s[7] != '-') {
+    return false;
+  }
+  uint32_t value;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  // YYYY from the first load, MM and DD from the high bytes of two overlapping ones: YYYYMMDD.
+  uint64_t first, last;
+  memcpy(&first, s, 8);
+  memcpy(&last, s + 2, 8);
+  uint64_t digits = (first & 0x00000000FFFFFFFF) | ((first >> 8) & 0x0000FFFF00000000) | (last & 0xFFFF000000000000);
+  if (!eightdigits(digits)) {
+    return false;
+  }
+  value = eightvalue(digits);
+#else
+  static const int positions[8] = {0, 1, 2, 3, 5, 6, 8, 9};
+  value = 0;
+  for (int i = 0; i < 8; i++) {
+    if ((unsigned char) (s[positions[i]] - '0') >= 10) {
+      return false;
+    }
+    value = value * 10 + (s[positions[i]] - '0');
+  }
+#endif
+  *year = value / 10000;
+  *month = value / 100 % 100;
+  *day = value % 100;
+  return dayofyear(*year, *month, *day) > 0;
+}
+
+size_t parseisodates(const char *p, size_t n, int32_t *days, size_t max, struct parseerror *error) {
+  const char *start = p, *end = p + n;
+  size_t count = 0;
+  error->reason = NULL;
+  while (count < max) {
+    while (p < end && isspace_(*p)) {
+      p++;
+    }
+    if (p == end) {
+      break;
+    }
+    int32_t year, month, day;
+    if (end - p < 10 || (end - p > 10 && !isspace_(p[10]))) {
+      error->reason = "not a YYYY-MM-DD date";
+    } else if (!parseisodate(p, &year, &month, &day)) {
+      error->reason = "not a valid date";
+    }
+    if (error->reason != NULL) {
+      error->offset = p - start;
+      return count;
+    }
+    days[count++] = daysfromcivil(year, month, day);
+    p += 10;
+  }
+  error->offset = p - start;
+  return count;
+}
@@ -0,0 +1,143 @@
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "filters.h"
+
+#define RUNBLOCK (1 << 20)
+
+// Bit i is set when byte i of the 16 at p is one of a or b.
+static inline unsigned matchmask(const char *p, char a, char b) {
+#ifdef __SSE2__
+  __m128i v = _mm_loadu_si128((const __m128i *) p);
+  return _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(a)), _mm_cmpeq_epi8(v, _mm_set1_epi8(b))));
+#else
+  unsigned m = 0;
+  for (int k = 0; k < 16; k++) {
+    m |= (unsigned) (p[k] == a || p[k] == b) << k;
+  }
+  return m;
+#endif
+}
+
+void countblanks::apply(const char *in, size_t n, std::string &) {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    blanks += __builtin_popcount(matchmask(in + i, ' ', '\t'));
+  }
+  for (; i < n; i++) {
+    blanks += in[i] == ' ' || in[i] == '\t';
+  }
+}
+
+void squeezeblanks::apply(const char *in, size_t n, std::string &out) {
+  size_t start = out.size(), i = 0;
+  out.resize(start + n);
+  char *q = &out[start];
+  for (; i + 16 <= n; i += 16) {
+    unsigned blank = matchmask(in + i, ' ', '\t');
+    // A blank right after another blank is dropped.
+    unsigned drop = blank & ((blank << 1) | inblank);
+    inblank = blank >> 15;
+    if (drop == 0) {
+#ifdef __SSE2__
+      __m128i v = _mm_loadu_si128((const __m128i *) (in + i));
+      __m128i tabs = _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'));
+      v = _mm_or_si128(_mm_andnot_si128(tabs, v), _mm_and_si128(tabs, _mm_set1_epi8(' ')));
+      _mm_storeu_si128((__m128i *) q, v);
+#else
+      for (int k = 0; k < 16; k++) {
+        q[k] = (blank >> k) & 1 ? ' ' : in[i + k];
+      }
+#endif
+      q += 16;
+      continue;
+    }
+    // Compress the block without a branch per byte: always write, only advance past kept bytes.
+    for (int k = 0; k < 16; k++) {
+      *q = (blank >> k) & 1 ? ' ' : in[i + k];
+      q += !((drop >> k) & 1);
+    }
+  }
+  for (; i < n; i++) {
+    bool blank = in[i] == ' ' || in[i] == '\t';
+    if (!blank || !inblank) {
+      *q++ = blank ? ' ' : in[i];
+    }
+    inblank = blank;
+  }
+  out.resize(q - out.data());
+}
+
+static inline void escape(char c, std::string &out) {
+  if (c == '\t') {
+    out += "\\t";
+  } else if (c == '\b') {
+    out += "\\b";
+  } else if (c == '\\') {
+    out += "\\\\";
+  } else {
+    out += c;
+  }
+}
+
+void escapespecials::apply(const char *in, size_t n, std::string &out) {
+  size_t i = 0, clean = 0;
+  for (; i + 16 <= n; i += 16) {
+    if ((matchmask(in + i, '\t', '\b') | matchmask(in + i, '\\', '\\')) == 0) {
+      continue;
+    }
+    // Copy everything up to this block in one go, then the block a character at a time.
+    out.append(in + clean, i - clean);
+    for (int k = 0; k < 16; k++) {
+      escape(in[i + k], out);
+    }
+    clean = i + 16;
+  }
+  out.append(in + clean, i - clean);
+  for (; i < n; i++) {
+    escape(in[i], out);
+  }
+}
+
+// Passes n bytes at data through filters[first] onwards and writes the result.
+static int passthrough(const std::vector<filter *> &filters, std::vector<std::string> &buffers, size_t first, const char *data, size_t n, FILE *out) {
+  for (size_t j = first; j < filters.size(); j++) {
+    if (filters[j]->observes_only()) {
+      filters[j]->apply(data, n, buffers[j]);
+      continue;
+    }
+    buffers[j].clear();
+    filters[j]->apply(data, n, buffers[j]);
+    data = buffers[j].data();
+    n = buffers[j].size();
+  }
+  return fwrite(data, 1, n, out) == n ? 0 : -1;
+}
+
+int runfilters(int fd, FILE *out, const std::vector<filter *> &filters) {
+  std::vector<std::string> buffers(filters.size());
+  std::string block(RUNBLOCK, '\0');
+  ssize_t n;
+  while ((n = read(fd, &block[0], RUNBLOCK)) != 0) {
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -1;
+    }
+    if (passthrough(filters, buffers, 0, block.data(), n, out) < 0) {
+      return -1;
+    }
+  }
+  for (size_t j = 0; j < filters.size(); j++) {
+    std::string held;
+    filters[j]->finish(held);
+    if (!held.empty() && passthrough(filters, buffers, j + 1, held.data(), held.size(), out) < 0) {
+      return -1;
+    }
+  }
+  return fflush(out) == EOF ? -1 : 0;
+}
@@ -0,0 +1,9 @@
+#include "fnv.h"
+
+unsigned long fnv1a(const char *p, size_t n) {
+  unsigned long h = 14695981039346656037UL;
+  for (size_t i = 0; i < n; i++) {
+    h = (h ^ (unsigned char) p[i]) * 1099511628211UL;
+  }
+  return h;
+}
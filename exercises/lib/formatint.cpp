@@ -0,0 +1,73 @@
+#include <string.h>
+#include "formatint.h"
+
+static const char digitpairs[201] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+static const uint64_t powersoften[20] = {
+  1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+  1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+  100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+  1000000000000000000ULL, 10000000000000000000ULL
+};
+
+int countdigits(uint64_t v) {
+  // 1233 / 4096 is just over log10(2), so this guesses log10 from the bit length, at most one too big.
+  // Zero counts as one digit.
+  int bits = 64 - __builtin_clzll(v | 1);
+  int guess = (bits * 1233) >> 12;
+  return guess + 1 - ((v | 1) < powersoften[guess]);
+}
+
+char *formatuint(uint64_t n, char *s) {
+  char *end = s + countdigits(n), *p = end;
+  while (n >= 100) {
+    unsigned pair = n % 100;
+    n /= 100;
+    p -= 2;
+    memcpy(p, digitpairs + 2 * pair, 2);
+  }
+  if (n >= 10) {
+    memcpy(p - 2, digitpairs + 2 * n, 2);
+  } else {
+    p[-1] = '0' + n;
+  }
+  return end;
+}
+
+char *formatint(int64_t n, char *s) {
+  // Negating in unsigned arithmetic is defined for INT64_MIN, where -n is not.
+  uint64_t magnitude = (uint64_t) n;
+  if (n < 0) {
+    *s++ = '-';
+    magnitude = 0 - magnitude;
+  }
+  return formatuint(magnitude, s);
+}
+
+size_t formatints32(const int32_t *values, size_t count, char *out, char separator) {
+  char *p = out;
+  for (size_t i = 0; i < count; i++) {
+    p = formatint(values[i], p);
+    *p++ = separator;
+  }
+  return p - out;
+}
+
+size_t formatints64(const int64_t *values, size_t count, char *out, char separator) {
+  char *p = out;
+  for (size_t i = 0; i < count; i++) {
+    p = formatint(values[i], p);
+    *p++ = separator;
+  }
+  return p - out;
+}
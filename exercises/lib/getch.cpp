@@ -1,17 +1,13 @@
 #include <stdio.h>
-#define BUFFSIZE 500
-
-char buf[BUFFSIZE];
-int bufp = 0;
+#include "getch.h"
+#include "reader.h"
 
 int getch(void) {
-  return (bufp > 0) ? buf[--bufp] : getchar();
+  return readch(stdinreader());
 }
 
 void ungetch(int c) {
-  if (bufp >= BUFFSIZE) {
+  if (unreadch(stdinreader(), c) < 0) {
     printf("ungetch: too many characters in buffer.\n");
-  } else {
-    buf[bufp++] = c;
   }
 }
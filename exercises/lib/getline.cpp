@@ -1,14 +1,6 @@
-#include <stdio.h>
+#include "getline.h"
+#include "reader.h"
 
 int getline(char s[], int lim) {
-  int c, i;
-  for (i = 0; i < lim - 1 && (c=getchar()) != EOF && c != '\n'; i++) {
-    s[i] = c;
-  }
-  if (c == '\n') {
-    s[i] = '\n';
-    i++;
-  }
-  s[i] = '\0';
-  return i;
-}
\ No newline at end of file
+  return readline(stdinreader(), s, lim);
+}
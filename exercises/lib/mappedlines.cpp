@@ -0,0 +1,75 @@
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mappedlines.h"
+
+#define CHUNKSIZE (1 << 20)
+
+int readinput(int fd, struct input *in) {
+  struct stat st;
+  in->data = NULL;
+  in->len = 0;
+  in->mapped = false;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+    if (st.st_size == 0) {
+      return 0;
+    }
+    void *p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED) {
+      madvise(p, st.st_size, MADV_SEQUENTIAL);
+      in->data = (char *) p;
+      in->len = st.st_size;
+      in->mapped = true;
+      return 0;
+    }
+  }
+
+  // Pipes can't be mapped, so read them in large chunks into a buffer that doubles as it fills.
+  size_t capacity = CHUNKSIZE;
+  ssize_t n = 0;
+  in->data = (char *) malloc(capacity);
+  while (in->data != NULL && (n = read(fd, in->data + in->len, capacity - in->len)) > 0) {
+    in->len += n;
+    if (in->len == capacity) {
+      capacity *= 2;
+      // On failure keep what was read in in->data, so freeinput still releases it.
+      char *grown = (char *) realloc(in->data, capacity);
+      if (grown == NULL) {
+        return -1;
+      }
+      in->data = grown;
+    }
+  }
+  return in->data == NULL || n < 0 ? -1 : 0;
+}
+
+void freeinput(struct input *in) {
+  if (in->mapped) {
+    munmap(in->data, in->len);
+  } else {
+    free(in->data);
+  }
+  in->data = NULL;
+  in->len = 0;
+}
+
+// A last line without a newline still counts.
+const char *nextline(const char *p, const char *end, std::string_view *line) {
+  const char *nl = (const char *) memchr(p, '\n', end - p);
+  if (nl == NULL) {
+    nl = end;
+  }
+  *line = std::string_view(p, nl - p);
+  return nl < end ? nl + 1 : end;
+}
+
+const char *readlines(const char *p, const char *end, std::vector<std::string_view> &lines, size_t maxlines) {
+  std::string_view line;
+  while (p < end && maxlines-- > 0) {
+    p = nextline(p, end, &line);
+    lines.push_back(line);
+  }
+  return p;
+}
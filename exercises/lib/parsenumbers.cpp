@@ -0,0 +1,184 @@
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include "chars.h"
+#include "parsenumbers.h"
+#include "swar.h"
+
+// An unsigned 64 bit value holds any 19 decimal digits.
+#define MAXDIGITS 19
+
+static inline bool isdigit_(char c) {
+  return (unsigned char) (c - '0') < 10;
+}
+
+/*
+  Adds the digits at p to *value, 8 at a time while there is room, and returns where they end.
+  *ndigits counts every digit; once it passes MAXDIGITS the rest are counted but not added.
+*/
+static const char *readdigits(const char *p, const char *end, uint64_t *value, int *ndigits) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  uint64_t chunk;
+  while (end - p >= 8 && *ndigits + 8 <= MAXDIGITS) {
+    memcpy(&chunk, p, 8);
+    if (!eightdigits(chunk)) {
+      break;
+    }
+    *value = *value * 100000000 + eightvalue(chunk);
+    *ndigits += 8;
+    p += 8;
+  }
+#endif
+  for (; p < end && isdigit_(*p); p++) {
+    if (*ndigits < MAXDIGITS) {
+      *value = *value * 10 + (*p - '0');
+    }
+    (*ndigits)++;
+  }
+  return p;
+}
+
+static inline const char *skipzeros(const char *p, const char *end) {
+  while (p < end && *p == '0') {
+    p++;
+  }
+  return p;
+}
+
+static size_t fail(struct parseerror *error, const char *start, const char *at, const char *reason, size_t count) {
+  error->offset = at - start;
+  error->reason = reason;
+  return count;
+}
+
+size_t parseints(const char *p, size_t n, int64_t *values, size_t max, struct parseerror *error) {
+  const char *start = p, *end = p + n;
+  size_t count = 0;
+  error->reason = NULL;
+  while (count < max) {
+    while (p < end && isspace_(*p)) {
+      p++;
+    }
+    if (p == end) {
+      break;
+    }
+    const char *token = p;
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') {
+      p++;
+    }
+    if (p == end || !isdigit_(*p)) {
+      return fail(error, start, token, "not a number", count);
+    }
+    uint64_t value = 0;
+    int ndigits = 0;
+    p = readdigits(skipzeros(p, end), end, &value, &ndigits);
+    if (p < end && !isspace_(*p)) {
+      return fail(error, start, p, "unexpected character", count);
+    }
+    if (ndigits > MAXDIGITS || value > (uint64_t) INT64_MAX + negative) {
+      return fail(error, start, token, "out of range", count);
+    }
+    values[count++] = negative ? (int64_t) (0 - value) : (int64_t) value;
+  }
+  error->offset = p - start;
+  return count;
+}
+
+// Powers of ten that a double holds exactly
+static const double exactpowers[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/*
+  Returns false when strtod is needed. When the digits fit in 53 bits and the power of ten is
+  exact, one multiply or divide of two exact doubles rounds correctly (Clinger's fast path).
+*/
+static bool fastdouble(uint64_t digits, int exponent, double *value) {
+  if (digits > (1ULL << 53) || exponent < -22 || exponent > 22) {
+    return false;
+  }
+  *value = exponent < 0 ? (double) digits / exactpowers[-exponent] : (double) digits * exactpowers[exponent];
+  return true;
+}
+
+size_t parsedoubles(const char *p, size_t n, double *values, size_t max, struct parseerror *error) {
+  const char *start = p, *end = p + n;
+  size_t count = 0;
+  error->reason = NULL;
+  while (count < max) {
+    while (p < end && isspace_(*p)) {
+      p++;
+    }
+    if (p == end) {
+      break;
+    }
+    const char *token = p;
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') {
+      p++;
+    }
+    uint64_t digits = 0;
+    int ndigits = 0, nfraction = 0;
+    const char *integer = p;
+    p = readdigits(skipzeros(p, end), end, &digits, &ndigits);
+    bool anydigits = p > integer;
+    if (p < end && *p == '.') {
+      const char *fraction = ++p;
+      // Zeros straight after the point only scale the value while nothing is accumulated yet.
+      if (ndigits == 0) {
+        p = skipzeros(p, end);
+      }
+      nfraction = p - fraction;
+      int before = ndigits;
+      p = readdigits(p, end, &digits, &ndigits);
+      nfraction += ndigits - before;
+      anydigits = anydigits || p > fraction;
+    }
+    if (!anydigits) {
+      return fail(error, start, token, "not a number", count);
+    }
+    int exponent = 0;
+    if (p < end && (*p == 'e' || *p == 'E')) {
+      const char *mark = p++;
+      bool negativeexponent = p < end && *p == '-';
+      if (p < end && (*p == '-' || *p == '+')) {
+        p++;
+      }
+      if (p == end || !isdigit_(*p)) {
+        return fail(error, start, mark, "exponent has no digits", count);
+      }
+      for (; p < end && isdigit_(*p); p++) {
+        // Past this the value is infinite or zero whatever the digits are.
+        if (exponent < 100000) {
+          exponent = exponent * 10 + (*p - '0');
+        }
+      }
+      if (negativeexponent) {
+        exponent = -exponent;
+      }
+    }
+    if (p < end && !isspace_(*p)) {
+      return fail(error, start, p, "unexpected character", count);
+    }
+
+    double value;
+    if (ndigits > MAXDIGITS || !fastdouble(digits, exponent - nfraction, &value)) {
+      // strtod rounds every other case correctly; it needs its own terminated copy of the token.
+      std::string copy(token, p - token);
+      errno = 0;
+      value = strtod(copy.c_str(), NULL);
+      if (errno == ERANGE && isinf(value)) {
+        return fail(error, start, token, "out of range", count);
+      }
+      values[count++] = value;
+      continue;
+    }
+    values[count++] = negative ? -value : value;
+  }
+  error->offset = p - start;
+  return count;
+}
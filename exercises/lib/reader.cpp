@@ -0,0 +1,67 @@
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include "reader.h"
+
+void initreader(struct reader *r, int fd) {
+  r->fd = fd;
+  r->pos = r->len = 0;
+  r->npushback = 0;
+}
+
+int fillreader(struct reader *r) {
+  ssize_t n;
+  while ((n = read(r->fd, r->buf, READERBUFSIZE)) < 0 && errno == EINTR)
+    ;
+  r->pos = 0;
+  r->len = n > 0 ? n : 0;
+  return r->len;
+}
+
+int unreadch(struct reader *r, int c) {
+  if (r->npushback >= PUSHBACKSIZE) {
+    return -1;
+  }
+  r->pushback[r->npushback++] = c;
+  return 0;
+}
+
+int readline(struct reader *r, char s[], int lim) {
+  int c, i = 0;
+  while (i < lim - 1 && r->npushback > 0) {
+    if ((c = r->pushback[--r->npushback]) == EOF) {
+      s[i] = '\0';
+      return i;
+    }
+    s[i++] = c;
+    if (c == '\n') {
+      s[i] = '\0';
+      return i;
+    }
+  }
+  // Copy whole runs of the buffer up to the next newline instead of a character at a time.
+  while (i < lim - 1 && (r->pos < r->len || fillreader(r) > 0)) {
+    size_t n = r->len - r->pos;
+    if (n > (size_t) (lim - 1 - i)) {
+      n = lim - 1 - i;
+    }
+    char *nl = (char *) memchr(r->buf + r->pos, '\n', n);
+    if (nl != NULL) {
+      n = nl - (r->buf + r->pos) + 1;
+    }
+    memcpy(s + i, r->buf + r->pos, n);
+    i += n;
+    r->pos += n;
+    if (nl != NULL) {
+      break;
+    }
+  }
+  s[i] = '\0';
+  return i;
+}
+
+struct reader *stdinreader(void) {
+  // Zero initialized, which is fd 0 with nothing buffered
+  static struct reader in;
+  return &in;
+}
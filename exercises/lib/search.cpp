@@ -0,0 +1,127 @@
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "search.h"
+
+bool ends_with(std::string_view s, std::string_view t) {
+  return t.size() <= s.size() && memcmp(s.data() + s.size() - t.size(), t.data(), t.size()) == 0;
+}
+
+size_t find(std::string_view haystack, std::string_view needle) {
+  size_t m = needle.size();
+  if (m == 0) {
+    return 0;
+  }
+  if (m > haystack.size()) {
+    return NOTFOUND;
+  }
+  const char *h = haystack.data(), *n = needle.data();
+  if (m == 1) {
+    const char *p = (const char *) memchr(h, n[0], haystack.size());
+    return p == NULL ? NOTFOUND : p - h;
+  }
+  // The last position a match can start at
+  size_t last = haystack.size() - m, i = 0;
+#ifdef __SSE2__
+  __m128i first = _mm_set1_epi8(n[0]), final = _mm_set1_epi8(n[m - 1]);
+  for (; i + 15 <= last; i += 16) {
+    __m128i starts = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (h + i)), first);
+    __m128i ends = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (h + i + m - 1)), final);
+    unsigned candidates = _mm_movemask_epi8(_mm_and_si128(starts, ends));
+    while (candidates != 0) {
+      int k = __builtin_ctz(candidates);
+      if (memcmp(h + i + k + 1, n + 1, m - 2) == 0) {
+        return i + k;
+      }
+      candidates &= candidates - 1;
+    }
+  }
+#endif
+  for (; i <= last; i++) {
+    if (h[i] == n[0] && h[i + m - 1] == n[m - 1] && memcmp(h + i + 1, n + 1, m - 2) == 0) {
+      return i;
+    }
+  }
+  return NOTFOUND;
+}
+
+void buildautomaton(struct automaton *a, const std::vector<std::string_view> &patterns) {
+  // Class 0 is every byte that no pattern uses.
+  memset(a->classof, 0, sizeof(a->classof));
+  a->nclasses = 1;
+  for (std::string_view pattern : patterns) {
+    for (char c : pattern) {
+      if (a->classof[(unsigned char) c] == 0) {
+        a->classof[(unsigned char) c] = a->nclasses++;
+      }
+    }
+  }
+  int k = a->nclasses;
+
+  // The trie, with -1 where it has no edge
+  a->next.assign(k, -1);
+  a->hit.assign(1, -1);
+  a->lengths.clear();
+  for (size_t p = 0; p < patterns.size(); p++) {
+    a->lengths.push_back(patterns[p].size());
+    if (patterns[p].empty()) {
+      continue;
+    }
+    int32_t state = 0;
+    for (char c : patterns[p]) {
+      int32_t &edge = a->next[state * k + a->classof[(unsigned char) c]];
+      if (edge < 0) {
+        edge = a->hit.size();
+        a->next.resize(a->next.size() + k, -1);
+        a->hit.push_back(-1);
+      }
+      // next may have moved, so look the edge up again.
+      state = a->next[state * k + a->classof[(unsigned char) c]];
+    }
+    if (a->hit[state] < 0) {
+      a->hit[state] = p;
+    }
+  }
+
+  // Breadth first, so each state's failure state is finished before it. Missing edges take
+  // the failure state's edge, which makes next a complete DFA.
+  std::vector<int32_t> fail(a->hit.size(), 0), queue;
+  for (int c = 0; c < k; c++) {
+    int32_t &edge = a->next[c];
+    if (edge < 0) {
+      edge = 0;
+    } else {
+      queue.push_back(edge);
+    }
+  }
+  for (size_t q = 0; q < queue.size(); q++) {
+    int32_t state = queue[q];
+    if (a->hit[state] < 0) {
+      a->hit[state] = a->hit[fail[state]];
+    }
+    for (int c = 0; c < k; c++) {
+      int32_t &edge = a->next[state * k + c];
+      if (edge < 0) {
+        edge = a->next[fail[state] * k + c];
+      } else {
+        fail[edge] = a->next[fail[state] * k + c];
+        queue.push_back(edge);
+      }
+    }
+  }
+}
+
+size_t findany(const struct automaton *a, std::string_view text, int *pattern) {
+  const int32_t *next = a->next.data(), *hit = a->hit.data();
+  int k = a->nclasses;
+  int32_t state = 0;
+  for (size_t i = 0; i < text.size(); i++) {
+    state = next[state * k + a->classof[(unsigned char) text[i]]];
+    if (hit[state] >= 0) {
+      *pattern = hit[state];
+      return i + 1 - a->lengths[hit[state]];
+    }
+  }
+  return NOTFOUND;
+}
@@ -0,0 +1,111 @@
+#include <stdlib.h>
+#include <string.h>
+#include "strbuilder.h"
+
+void initbuilder(struct strbuilder *b, bool rope) {
+  b->rope = rope;
+  b->len = 0;
+  b->cap = rope ? ROPECHUNK : 16;
+  b->data = (char *) malloc(b->cap + !rope);
+  if (!rope) {
+    b->data[0] = '\0';
+  }
+  b->chunks.clear();
+}
+
+void freebuilder(struct strbuilder *b) {
+  for (char *chunk : b->chunks) {
+    free(chunk);
+  }
+  b->chunks.clear();
+  free(b->data);
+  b->data = NULL;
+  b->len = b->cap = 0;
+}
+
+size_t builderlength(const struct strbuilder *b) {
+  return b->chunks.size() * (size_t) ROPECHUNK + b->len;
+}
+
+// Room for n more characters and a terminator, doubling so n appends cost O(n) copies in all.
+static void reserve(struct strbuilder *b, size_t n) {
+  if (b->len + n <= b->cap) {
+    return;
+  }
+  if (b->cap == 0) {
+    b->cap = 16;
+  }
+  while (b->len + n > b->cap) {
+    b->cap *= 2;
+  }
+  b->data = (char *) realloc(b->data, b->cap + 1);
+  if (b->data == NULL) {
+    abort();
+  }
+}
+
+char *builderncat(struct strbuilder *b, const char *source, size_t n) {
+  n = strnlen(source, n);
+  if (!b->rope) {
+    reserve(b, n);
+    memcpy(b->data + b->len, source, n);
+    b->len += n;
+    b->data[b->len] = '\0';
+    return b->data + b->len;
+  }
+  while (n > 0) {
+    if (b->len == ROPECHUNK) {
+      b->chunks.push_back(b->data);
+      b->data = (char *) malloc(ROPECHUNK);
+      if (b->data == NULL) {
+        abort();
+      }
+      b->len = 0;
+    }
+    size_t part = n < ROPECHUNK - b->len ? n : ROPECHUNK - b->len;
+    memcpy(b->data + b->len, source, part);
+    b->len += part;
+    source += part;
+    n -= part;
+  }
+  return b->data + b->len;
+}
+
+char *builderncpy(struct strbuilder *b, const char *source, size_t n) {
+  bool rope = b->rope;
+  freebuilder(b);
+  initbuilder(b, rope);
+  return builderncat(b, source, n);
+}
+
+char *flatten(struct strbuilder *b) {
+  if (!b->rope) {
+    return b->data;
+  }
+  size_t total = builderlength(b);
+  char *joined = (char *) malloc(total + 1);
+  if (joined == NULL) {
+    abort();
+  }
+  char *p = joined;
+  for (char *chunk : b->chunks) {
+    memcpy(p, chunk, ROPECHUNK);
+    p += ROPECHUNK;
+  }
+  memcpy(p, b->data, b->len);
+  joined[total] = '\0';
+  freebuilder(b);
+  b->rope = false;
+  b->data = joined;
+  b->len = b->cap = total;
+  return joined;
+}
+
+bool builderwrite(const struct strbuilder *b, FILE *out) {
+  for (char *chunk : b->chunks) {
+    if (fwrite(chunk, 1, ROPECHUNK, out) != ROPECHUNK) {
+      return false;
+    }
+  }
+  return fwrite(b->data, 1, b->len, out) == b->len;
+}
@@ -0,0 +1,43 @@
+#ifndef FUZZER_DEFS
+#define FUZZER_DEFS
+#include <string>
+#include <vector>
+#include <Reference.hpp>
+
+namespace gerryfudd::fuzz {
+  /*
+    One fast path under test. actual computes a op b with the code in ./lib and expected
+    computes it with the reference. Operands are generated up to max_words long.
+  */
+  struct Check {
+    const char *name;
+    gerryfudd::math::BigInt (*actual)(const Reference&, const Reference&);
+    Reference (*expected)(const Reference&, const Reference&);
+    unsigned long max_words;
+  };
+
+  const std::vector<Check>& all_checks();
+  // Whether the check agrees with the reference. Exceptions from the fast path count as disagreement.
+  bool passes(const Check&, const Reference&, const Reference&);
+
+  /*
+    Operands up to max_words long for case number index of a run with the given seed. Lengths
+    favour the sizes around each algorithm threshold, and words favour the shapes that stress carries: all ones,
+    long carry chains, single bits, sparse words and values equal to or opposite each other.
+  */
+  void generate_case(unsigned long, unsigned long, unsigned long, Reference&, Reference&);
+
+  // Shrinks failing operands one step at a time for as long as the check keeps failing.
+  void minimize(const Check&, Reference&, Reference&);
+
+  /*
+    Command line options for the fuzz binary.
+      --threads=N   fuzz on N threads, 0 (the default) for one per core
+      --seconds=S   stop after S seconds, 10 by default
+      --cases=N     stop after N cases instead
+      --seed=S      seed for the run, printed at the start so a failure can be reproduced
+      --check=S     only run the checks whose name contains S
+  */
+  int run_fuzzer(int, char **);
+}
+#endif
@@ -0,0 +1,29 @@
+#ifndef REFERENCE_DEFS
+#define REFERENCE_DEFS
+#include <iostream>
+#include <vector>
+#include <math/BigInt.hpp>
+
+namespace gerryfudd::fuzz {
+  /*
+    Sign and magnitude arithmetic written as plainly as possible, to check the fast paths in
+    ./lib against. Magnitudes are 32 bit words, least significant first, with no leading zero
+    words, and zero is never negative.
+  */
+  struct Reference {
+    std::vector<unsigned int> magnitude;
+    bool sign;
+  };
+
+  Reference normalized(Reference);
+  Reference reference_add(const Reference&, const Reference&);
+  Reference reference_sub(const Reference&, const Reference&);
+  Reference reference_mult(const Reference&, const Reference&);
+  // The value times 2^(32 * words)
+  Reference reference_shift(const Reference&, unsigned short);
+
+  gerryfudd::math::BigInt to_big_int(const Reference&);
+  bool matches(const gerryfudd::math::BigInt&, const Reference&);
+  std::ostream& operator<<(std::ostream&, const Reference&);
+}
+#endif
@@ -0,0 +1,369 @@
+#include <Fuzzer.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <math/BigIntBatch.hpp>
+#include <math/BigIntExpr.hpp>
+#include <math/FixedInt.hpp>
+
+using namespace gerryfudd::math;
+
+namespace gerryfudd::fuzz {
+  // ********** BEGIN checks **********
+  // Multiplication at or above BigInt's TOOM_COOK_THRESHOLD (240 words) is not implemented yet.
+  const unsigned long MULT_MAX_WORDS = 239;
+  // Operands that always fit FixedInt<512> with room for their full product
+  const unsigned long FIXED_MAX_WORDS = 7;
+  const unsigned long ANY_LENGTH = 1000;
+  // Enough lanes for several of BigIntBatch's 256 lane blocks, so that every thread gets some
+  const unsigned long THREADED_LANES = 3 * 256 + 2;
+  // Wider products stay on two lanes, where the batch runs on one thread, to keep each case quick.
+  const unsigned long THREADED_PRODUCT_MAX_WORDS = 32;
+
+  Reference lazy_expected(const Reference& a, const Reference& b) {
+    return reference_add(reference_sub(a, b), reference_shift(b, 1));
+  }
+
+  BigInt lazy_actual(const Reference& a, const Reference& b) {
+    BigInt x = to_big_int(a), y = to_big_int(b);
+    return lazy(x) - y + lazy(y, 1);
+  }
+
+  /*
+    Puts a op b in the even lanes and b op a in the odd ones, at both ends of the batch, and
+    returns lane 0 once the others have been checked too. The thread count varies with the
+    operands, so a failing case replays with the same one.
+  */
+  template <void (*Operation)(const BigIntBatch&, const BigIntBatch&, BigIntBatch&, unsigned int), bool Product>
+  BigInt batch_actual(const Reference& a, const Reference& b) {
+    unsigned short width = std::max(a.magnitude.size(), b.magnitude.size()) + 1;
+    unsigned int threads = 1 + (a.magnitude.size() + 3 * b.magnitude.size()) % 4;
+    unsigned long lanes = threads > 1 && (!Product || width <= THREADED_PRODUCT_MAX_WORDS) ? THREADED_LANES : 2;
+    BigIntBatch x(lanes, width), y(lanes, width), result(lanes, Product ? 2 * width : width + 1);
+    BigInt big_a = to_big_int(a), big_b = to_big_int(b);
+    const unsigned long used[] = {0, 1, lanes - 2, lanes - 1};
+    for (unsigned long lane : used) {
+      x.set(lane, lane % 2 == 0 ? big_a : big_b);
+      y.set(lane, lane % 2 == 0 ? big_b : big_a);
+    }
+    Operation(x, y, result, threads);
+    Reference forward = Product ? reference_mult(a, b) : (Operation == batch_add ? reference_add(a, b) : reference_sub(a, b));
+    Reference swapped = Product ? reference_mult(b, a) : (Operation == batch_add ? reference_add(b, a) : reference_sub(b, a));
+    for (unsigned long lane : used) {
+      if (lane % 2 == 0 && !matches(result.get(lane), forward)) {
+        return result.get(lane);
+      }
+      if (lane % 2 == 1 && !matches(result.get(lane), swapped)) {
+        // Report the swapped lane's value, which can never equal the expected one here.
+        return result.get(lane) + BigInt(1);
+      }
+    }
+    return result.get(0);
+  }
+
+  template <int Operation>
+  BigInt fixed_actual(const Reference& a, const Reference& b) {
+    FixedInt<512> x(to_big_int(a)), y(to_big_int(b));
+    return (Operation == 0 ? x + y : Operation == 1 ? x - y : x * y).to_big_int();
+  }
+
+  const std::vector<Check>& all_checks() {
+    static const std::vector<Check> checks = {
+      {"add", [](const Reference& a, const Reference& b) { return to_big_int(a) + to_big_int(b); }, reference_add, ANY_LENGTH},
+      {"sub", [](const Reference& a, const Reference& b) { return to_big_int(a) - to_big_int(b); }, reference_sub, ANY_LENGTH},
+      {"mult", [](const Reference& a, const Reference& b) { return to_big_int(a) * to_big_int(b); }, reference_mult, MULT_MAX_WORDS},
+      {"add_view", [](const Reference& a, const Reference& b) { BigInt y = to_big_int(b); return to_big_int(a) + y.view(); }, reference_add, ANY_LENGTH},
+      {"sub_view", [](const Reference& a, const Reference& b) { BigInt y = to_big_int(b); return to_big_int(a) - y.view(); }, reference_sub, ANY_LENGTH},
+      {"mult_view", [](const Reference& a, const Reference& b) { BigInt y = to_big_int(b); return to_big_int(a) * y.view(); }, reference_mult, MULT_MAX_WORDS},
+      {"lazy_sum", lazy_actual, lazy_expected, ANY_LENGTH},
+      {"batch_add", batch_actual<batch_add, false>, reference_add, ANY_LENGTH},
+      {"batch_sub", batch_actual<batch_sub, false>, reference_sub, ANY_LENGTH},
+      {"batch_mult", batch_actual<batch_mult, true>, reference_mult, ANY_LENGTH},
+      {"fixed_add", fixed_actual<0>, reference_add, FIXED_MAX_WORDS},
+      {"fixed_sub", fixed_actual<1>, reference_sub, FIXED_MAX_WORDS},
+      {"fixed_mult", fixed_actual<2>, reference_mult, FIXED_MAX_WORDS},
+    };
+    return checks;
+  }
+
+  bool passes(const Check& check, const Reference& a, const Reference& b) {
+    try {
+      return matches(check.actual(a, b), check.expected(a, b));
+    } catch (std::exception&) {
+      return false;
+    }
+  }
+  // ********** END checks **********
+
+  // ********** BEGIN generation **********
+  // Each threshold, one word either side of it, the sizes Karatsuba splits those into, and long
+  // operands for the checks that take any length
+  const unsigned long INTERESTING_LENGTHS[] = {
+    0, 1, 2, 3, 4, 7, 8, 9, 15, 16, 17, 31, 32, 33, 39, 40, 41, 63, 64, 65,
+    79, 80, 81, 119, 120, 121, 159, 160, 161, 238, 239, 240, 241, 255, 256, 257, 511, 512, 513, 999, 1000
+  };
+  const unsigned long INTERESTING_LENGTH_COUNT = sizeof(INTERESTING_LENGTHS) / sizeof(INTERESTING_LENGTHS[0]);
+
+  // splitmix64, so that any case can be regenerated from the seed and its index alone
+  struct Random {
+    unsigned long state;
+    unsigned long next() {
+      unsigned long z = (state += 0x9e3779b97f4a7c15UL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9UL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebUL;
+      return z ^ (z >> 31);
+    }
+    unsigned long below(unsigned long limit) {
+      return next() % limit;
+    }
+  };
+
+  // A length up to limit; threshold lengths past the limit are redrawn from the whole range.
+  unsigned long pick_length(Random& random, unsigned long limit) {
+    unsigned long roll = random.below(10);
+    if (roll < 5) {
+      return random.below(std::min(9UL, limit + 1));
+    }
+    if (roll < 8) {
+      unsigned long length = INTERESTING_LENGTHS[random.below(INTERESTING_LENGTH_COUNT)];
+      if (length <= limit) {
+        return length;
+      }
+    }
+    return random.below(limit + 1);
+  }
+
+  unsigned int pick_word(Random& random, unsigned long shape, unsigned long index, unsigned long length) {
+    switch (shape) {
+      case 0:
+        return (unsigned int) random.next();
+      case 1:
+        return 0xffffffff;
+      case 2:
+        // A run of ones under a random top, so that adding one ripples all the way up
+        return index + 1 < length ? 0xffffffff : (unsigned int) random.next();
+      case 3:
+        // A single bit near the top
+        return index + 1 < length ? 0 : 1u << random.below(32);
+      case 4:
+        return random.below(8) == 0 ? (unsigned int) random.next() : 0;
+      case 5:
+        return index % 2 == 0 ? 0 : 0xffffffff;
+      default:
+        // Top bit set in the top word, the edge of a lane in two's complement
+        return index + 1 < length ? (unsigned int) random.next() : 0x80000000 | (unsigned int) random.next();
+    }
+  }
+
+  Reference pick_operand(Random& random, unsigned long limit) {
+    unsigned long length = pick_length(random, limit), shape = random.below(7);
+    Reference value{std::vector<unsigned int>(length), random.below(2) == 0};
+    for (unsigned long i = 0; i < length; i++) {
+      value.magnitude[i] = pick_word(random, shape, i, length);
+    }
+    if (length > 0 && value.magnitude.back() == 0) {
+      value.magnitude.back() = 1;
+    }
+    return normalized(value);
+  }
+
+  void generate_case(unsigned long seed, unsigned long index, unsigned long max_words, Reference& a, Reference& b) {
+    Random random{seed ^ (index * 0xd1342543de82ef95UL)};
+    a = pick_operand(random, max_words);
+    switch (random.below(8)) {
+      case 0:
+        b = a;
+        break;
+      case 1:
+        b = normalized({a.magnitude, !a.sign});
+        break;
+      case 2:
+        // One away from a, so that a - b and a + b carry or cancel across every word
+        b = reference_add(a, {{1}, random.below(2) == 0});
+        break;
+      default:
+        b = pick_operand(random, max_words);
+    }
+  }
+  // ********** END generation **********
+
+  // ********** BEGIN minimization **********
+  // Tries a simpler operand and keeps it when the check still fails.
+  bool still_fails(const Check& check, Reference& a, Reference& b, Reference& operand, Reference candidate) {
+    Reference original = operand;
+    operand = normalized(candidate);
+    if (!passes(check, a, b)) {
+      return true;
+    }
+    operand = original;
+    return false;
+  }
+
+  /*
+    Removes runs of words, halving the run length down to single words as in delta debugging,
+    then simplifies the words that remain. Repeats until nothing changes, so the result is as
+    short and plain as this search can make it.
+  */
+  void minimize(const Check& check, Reference& a, Reference& b) {
+    bool progress = true;
+    while (progress) {
+      progress = false;
+      Reference *operands[] = {&a, &b};
+      for (int o = 0; o < 2; o++) {
+        Reference& operand = *operands[o];
+        if (operand.sign && still_fails(check, a, b, operand, {operand.magnitude, false})) {
+          progress = true;
+        }
+        for (unsigned long run = std::max(1UL, operand.magnitude.size() / 2); run > 0; run /= 2) {
+          unsigned long begin = 0;
+          while (begin < operand.magnitude.size()) {
+            std::vector<unsigned int> shorter(operand.magnitude);
+            shorter.erase(shorter.begin() + begin, shorter.begin() + std::min(begin + run, shorter.size()));
+            if (still_fails(check, a, b, operand, {shorter, operand.sign})) {
+              progress = true;
+            } else {
+              begin += run;
+            }
+          }
+        }
+        const unsigned int simpler[] = {0, 1, 0xffffffff};
+        for (unsigned long i = 0; i < operand.magnitude.size(); i++) {
+          for (int s = 0; s < 3 && operand.magnitude[i] != simpler[s]; s++) {
+            std::vector<unsigned int> replaced(operand.magnitude);
+            replaced[i] = simpler[s];
+            if (still_fails(check, a, b, operand, {replaced, operand.sign})) {
+              progress = true;
+              break;
+            }
+          }
+        }
+      }
+    }
+  }
+  // ********** END minimization **********
+
+  // ********** BEGIN driver **********
+  const double DEFAULT_SECONDS = 10;
+  // Cases a thread claims at a time, so that threads rarely touch the shared counter
+  const unsigned long CASES_PER_CLAIM = 256;
+
+  struct Failure {
+    const Check *check;
+    unsigned long index;
+    Reference a;
+    Reference b;
+  };
+
+  const char *option_value(const char *arg, const char *option) {
+    size_t length = std::strlen(option);
+    if (std::strncmp(arg, option, length) == 0) {
+      return arg + length;
+    }
+    return nullptr;
+  }
+
+  int run_fuzzer(int argc, char **argv) {
+    unsigned int threads = 0;
+    double seconds = DEFAULT_SECONDS;
+    unsigned long max_cases = 0, seed = std::chrono::steady_clock::now().time_since_epoch().count();
+    std::string only;
+    const char *value;
+    for (int i = 1; i < argc; i++) {
+      if ((value = option_value(argv[i], "--threads=")) != nullptr) {
+        threads = std::strtoul(value, nullptr, 10);
+      } else if ((value = option_value(argv[i], "--seconds=")) != nullptr) {
+        seconds = std::strtod(value, nullptr);
+      } else if ((value = option_value(argv[i], "--cases=")) != nullptr) {
+        max_cases = std::strtoul(value, nullptr, 10);
+      } else if ((value = option_value(argv[i], "--seed=")) != nullptr) {
+        seed = std::strtoul(value, nullptr, 10);
+      } else if ((value = option_value(argv[i], "--check=")) != nullptr) {
+        only = value;
+      } else {
+        std::cerr << "Unknown option " << argv[i] << std::endl
+          << "Usage: " << argv[0] << " [--threads=<n>] [--seconds=<s>] [--cases=<n>] [--seed=<n>] [--check=<substring>]" << std::endl;
+        return 1;
+      }
+    }
+    if (threads == 0) {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::vector<const Check*> checks;
+    for (std::vector<Check>::const_iterator check = all_checks().begin(); check != all_checks().end(); check++) {
+      if (std::string(check->name).find(only) != std::string::npos) {
+        checks.push_back(&*check);
+      }
+    }
+    std::cout << "Fuzzing " << checks.size() << " checks on " << threads << " threads with --seed=" << seed << std::endl;
+
+    std::atomic<unsigned long> next_case{0}, finished_cases{0};
+    std::atomic<bool> stop{false};
+    std::mutex failure_lock;
+    std::vector<Failure> failures;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now(),
+      deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+
+    auto worker = [&]() {
+      Reference a, b;
+      while (!stop.load(std::memory_order_relaxed)) {
+        unsigned long first = next_case.fetch_add(CASES_PER_CLAIM), last = first + CASES_PER_CLAIM;
+        if (max_cases > 0 && last > max_cases) {
+          last = max_cases;
+        }
+        for (unsigned long index = first; index < last && !stop.load(std::memory_order_relaxed); index++) {
+          unsigned long generated_for = 0;
+          for (std::vector<const Check*>::iterator check = checks.begin(); check != checks.end(); check++) {
+            if ((*check)->max_words != generated_for) {
+              generated_for = (*check)->max_words;
+              generate_case(seed, index, generated_for, a, b);
+            }
+            // a plus or minus one can still be a word longer than the limit.
+            if (a.magnitude.size() > (*check)->max_words || b.magnitude.size() > (*check)->max_words || passes(**check, a, b)) {
+              continue;
+            }
+            // Stop the other threads first, since minimizing can take a while.
+            stop.store(true);
+            Failure failure{*check, index, a, b};
+            minimize(**check, failure.a, failure.b);
+            std::lock_guard<std::mutex> guard(failure_lock);
+            failures.push_back(failure);
+            break;
+          }
+          finished_cases.fetch_add(1, std::memory_order_relaxed);
+        }
+        if ((max_cases > 0 && last >= max_cases) || (max_cases == 0 && std::chrono::steady_clock::now() >= deadline)) {
+          stop.store(true);
+        }
+      }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < threads; t++) {
+      workers.emplace_back(worker);
+    }
+    for (std::vector<std::thread>::iterator t = workers.begin(); t != workers.end(); t++) {
+      t->join();
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    unsigned long cases = finished_cases.load();
+    std::cout << cases << " cases in " << elapsed << " s, " << (unsigned long) (cases / elapsed) << " cases/s" << std::endl;
+    for (std::vector<Failure>::iterator failure = failures.begin(); failure != failures.end(); failure++) {
+      std::cout << std::endl << "FAILED " << failure->check->name << " on case " << failure->index
+        << " (rerun with --seed=" << seed << "), minimized to" << std::endl
+        << "  a = " << failure->a << std::endl
+        << "  b = " << failure->b << std::endl
+        << "  expected " << failure->check->expected(failure->a, failure->b) << std::endl;
+      try {
+        std::cout << "  actual   " << failure->check->actual(failure->a, failure->b).as_hex_string() << std::endl;
+      } catch (std::exception& e) {
+        std::cout << "  actual   threw " << e.what() << std::endl;
+      }
+    }
+    return failures.empty() ? 0 : 1;
+  }
+  // ********** END driver **********
+}
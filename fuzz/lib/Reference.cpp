@@ -0,0 +1,105 @@
+#include <Reference.hpp>
+#include <iomanip>
+
+namespace gerryfudd::fuzz {
+  Reference normalized(Reference value) {
+    while (!value.magnitude.empty() && value.magnitude.back() == 0) {
+      value.magnitude.pop_back();
+    }
+    if (value.magnitude.empty()) {
+      value.sign = false;
+    }
+    return value;
+  }
+
+  bool magnitude_less(const std::vector<unsigned int>& a, const std::vector<unsigned int>& b) {
+    if (a.size() != b.size()) {
+      return a.size() < b.size();
+    }
+    for (unsigned long i = a.size(); i > 0; i--) {
+      if (a[i - 1] != b[i - 1]) {
+        return a[i - 1] < b[i - 1];
+      }
+    }
+    return false;
+  }
+
+  std::vector<unsigned int> magnitude_add(const std::vector<unsigned int>& a, const std::vector<unsigned int>& b) {
+    std::vector<unsigned int> result(std::max(a.size(), b.size()) + 1, 0);
+    unsigned long carry = 0;
+    for (unsigned long i = 0; i < result.size(); i++) {
+      carry += i < a.size() ? a[i] : 0;
+      carry += i < b.size() ? b[i] : 0;
+      result[i] = (unsigned int) carry;
+      carry >>= 32;
+    }
+    return result;
+  }
+
+  // Expects a >= b
+  std::vector<unsigned int> magnitude_sub(const std::vector<unsigned int>& a, const std::vector<unsigned int>& b) {
+    std::vector<unsigned int> result(a.size(), 0);
+    long borrow = 0;
+    for (unsigned long i = 0; i < a.size(); i++) {
+      long difference = (long) a[i] - (i < b.size() ? (long) b[i] : 0) - borrow;
+      borrow = difference < 0 ? 1 : 0;
+      result[i] = (unsigned int) (difference + (borrow << 32));
+    }
+    return result;
+  }
+
+  Reference reference_add(const Reference& a, const Reference& b) {
+    if (a.sign == b.sign) {
+      return normalized({magnitude_add(a.magnitude, b.magnitude), a.sign});
+    }
+    if (magnitude_less(a.magnitude, b.magnitude)) {
+      return normalized({magnitude_sub(b.magnitude, a.magnitude), b.sign});
+    }
+    return normalized({magnitude_sub(a.magnitude, b.magnitude), a.sign});
+  }
+
+  Reference reference_sub(const Reference& a, const Reference& b) {
+    return reference_add(a, normalized({b.magnitude, !b.sign}));
+  }
+
+  Reference reference_mult(const Reference& a, const Reference& b) {
+    std::vector<unsigned int> result(a.magnitude.size() + b.magnitude.size(), 0);
+    for (unsigned long i = 0; i < a.magnitude.size(); i++) {
+      unsigned long carry = 0;
+      for (unsigned long j = 0; j < b.magnitude.size(); j++) {
+        carry += (unsigned long) a.magnitude[i] * b.magnitude[j] + result[i + j];
+        result[i + j] = (unsigned int) carry;
+        carry >>= 32;
+      }
+      result[i + b.magnitude.size()] = (unsigned int) carry;
+    }
+    return normalized({result, a.sign != b.sign});
+  }
+
+  Reference reference_shift(const Reference& value, unsigned short words) {
+    std::vector<unsigned int> result(words, 0);
+    result.insert(result.end(), value.magnitude.begin(), value.magnitude.end());
+    return normalized({result, value.sign});
+  }
+
+  gerryfudd::math::BigInt to_big_int(const Reference& value) {
+    if (value.magnitude.empty()) {
+      return gerryfudd::math::BigInt();
+    }
+    return gerryfudd::math::BigInt(value.magnitude, value.sign);
+  }
+
+  bool matches(const gerryfudd::math::BigInt& actual, const Reference& expected) {
+    gerryfudd::math::BigIntView view = actual.view();
+    Reference value = normalized({std::vector<unsigned int>(view.words, view.words + view.length), view.sign});
+    return value.sign == expected.sign && value.magnitude == expected.magnitude;
+  }
+
+  std::ostream& operator<<(std::ostream& out, const Reference& value) {
+    out << (value.sign ? "-" : "") << "{";
+    for (unsigned long i = 0; i < value.magnitude.size(); i++) {
+      out << (i > 0 ? ", " : "") << "0x" << std::hex << value.magnitude[i] << std::dec;
+    }
+    return out << "} (" << value.magnitude.size() << " words)";
+  }
+}
@@ -0,0 +1,7 @@
+#include <Fuzzer.hpp>
+
+using namespace gerryfudd::fuzz;
+
+int main(int argc, char **argv) {
+    return run_fuzzer(argc, argv);
+}
@@ -1,26 +1,47 @@
 #ifndef ENRICHED_EXCEPTION_TYPE
 #define ENRICHED_EXCEPTION_TYPE
+#include <cstdint>
 #include <exception>
 #include <iostream>
 #include <string>
+#include <vector>
 
 using namespace std;
 
 namespace gerryfudd::exception_utils {
+    /*
+        How much of the stack an enriched_exception records when it is created.
+            none       just the message, for exceptions used as ordinary control flow
+            addresses  the return addresses, named only if the exception is printed
+            full       the addresses and their names, resolved straight away
+        Names come from the process-wide cache in stack_trace.hpp, so even full capture only
+        pays for the lookup the first time a frame is seen.
+    */
+    enum class capture_level { none, addresses, full };
+
+    // The level used by exceptions that do not ask for one. Starts as addresses.
+    void set_default_capture_level(capture_level);
+    capture_level default_capture_level();
+
     /*
         This exception accepts either a char pointer or a string in its constructor and automatically
         captures the current stack trace. Its void what() implementation returns the message and it
         streams the message and full stack trace when you use the << operator.
     */ 
     class enriched_exception: public exception {
+        static const unsigned short TRACE_CAPACITY = 64;
         string message;
-        string stack_trace;
+        unsigned short trace_depth;
+        uintptr_t trace[TRACE_CAPACITY];
+        vector<string> symbols;
+        void capture(capture_level);
     public:
         enriched_exception(string);
+        enriched_exception(string, capture_level);
         virtual const char * what() const _GLIBCXX_TXN_SAFE_DYN _GLIBCXX_NOTHROW override;
 
         friend ostream& operator<<(ostream&,const enriched_exception&);
     };
 }
 
-#endif
\ No newline at end of file
+#endif
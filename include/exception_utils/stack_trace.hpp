@@ -0,0 +1,21 @@
+#ifndef STACK_TRACE_DEFS
+#define STACK_TRACE_DEFS
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+namespace gerryfudd::exception_utils {
+    /*
+        Stack traces in two steps. capture_stack only records the return addresses of the
+        calling frames, which is cheap enough to do every time an exception is created.
+        symbol_for turns one of those addresses into a demangled function name when the trace
+        is actually printed. Names are cached for the whole process and the cache is shared
+        by every thread, so each address is only looked up once.
+    */
+
+    // Fills the array with up to capacity addresses, starting skip frames above the caller, and returns how many it wrote.
+    unsigned short capture_stack(uintptr_t *, unsigned short, unsigned short);
+    string symbol_for(uintptr_t);
+}
+#endif
@@ -1,11 +1,23 @@
 #ifndef BIGINT_DEF
 #define BIGINT_DEF
+#include <span>
 #include <string>
 #include <vector>
 
 using namespace std;
 
 namespace gerryfudd::math {
+    /*
+        A read-only BigInt that lives in memory owned by someone else, such as a memory mapped
+        file. words points at length 32 bit words, least significant first, with no leading zero
+        words. The memory must outlive the view.
+    */
+    struct BigIntView {
+        const unsigned int *words;
+        size_t length;
+        bool sign;
+    };
+
     class BigInt {
         static const unsigned short KARATSUBA_THRESHOLD;
         // static const unsigned short KARATSUBA_SQUARE_THRESHOLD;
@@ -15,12 +27,13 @@ namespace gerryfudd::math {
         vector<unsigned int> magnitude;
         // True indicates that the underlying int is negative
         bool sign;
-        BigInt do_add(vector<unsigned int>);
-        BigInt do_sub(vector<unsigned int>);
-        static BigInt sub_from_larger(vector<unsigned int>, vector<unsigned int>, bool);
+        BigInt do_add(span<const unsigned int>);
+        BigInt do_sub(span<const unsigned int>);
+        static BigInt sub_from_larger(span<const unsigned int>, span<const unsigned int>, bool);
         BigInt mult (const BigInt&, bool);
-        static BigInt multiply_by_long(vector<unsigned int>, unsigned long, bool);
-        static BigInt multiply_to_len(vector<unsigned int>, vector<unsigned int>, bool);
+        static BigInt multiply_below_karatsuba(span<const unsigned int>, span<const unsigned int>, bool);
+        static BigInt multiply_by_long(span<const unsigned int>, unsigned long, bool);
+        static BigInt multiply_to_len(span<const unsigned int>, span<const unsigned int>, bool);
         static BigInt get_lower(const BigInt&, unsigned short);
         static BigInt get_upper(const BigInt&, unsigned short);
         BigInt shift(int);
@@ -31,17 +44,33 @@ namespace gerryfudd::math {
         BigInt (unsigned int [], unsigned short, bool);
         BigInt (unsigned int, bool);
         BigInt (unsigned int);
+        explicit BigInt (const BigIntView&);
+        static BigInt from_decimal_string(const string&);
+        static BigInt from_hex_string(const string&);
         string as_decimal_string() const;
         string as_hex_string () const;
+        BigIntView view() const;
         BigInt operator + (const BigInt&);
+        BigInt operator + (const BigIntView&);
         BigInt operator - (const BigInt&);
+        BigInt operator - (const BigIntView&);
         BigInt operator - ();
         BigInt abs();
 
         BigInt operator * (const BigInt&);
+        BigInt operator * (const BigIntView&);
 
         friend bool operator== (const BigInt&, const BigInt&);
+        friend class BigIntBatch;
+        template <unsigned int> friend class FixedInt;
+        friend class LazyTerm;
         friend ostream& operator<<(ostream&, const BigInt&);
+        /*
+            Describes how two values differ without printing them whole: each one's length and
+            sign, the lowest word where they differ and a few words of hex either side of it.
+            assert_equal uses this for BigInts, so a failing test on megaword values stays fast.
+        */
+        friend void describe_difference(ostream&, const BigInt&, const BigInt&);
     };
 }
 #endif
\ No newline at end of file
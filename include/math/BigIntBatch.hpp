@@ -0,0 +1,40 @@
+#ifndef BIGINT_BATCH_DEF
+#define BIGINT_BATCH_DEF
+#include <vector>
+#include <math/BigInt.hpp>
+
+using namespace std;
+
+namespace gerryfudd::math {
+    /*
+        Many same-width operands laid out as a structure of arrays. Every lane holds one value
+        in two's complement with a fixed number of 32 bit words, and word i of every lane is
+        stored contiguously. The batch operations walk one word index at a time across all
+        lanes, so the inner loops have no sign handling or allocation and can be vectorized.
+
+        Results are taken modulo 2^(32 * width of the output batch). They are exact whenever the
+        output is one word wider than the widest operand (add and sub) or as wide as both
+        operands combined (mult).
+    */
+    class BigIntBatch {
+        unsigned long lanes;
+        unsigned short width;
+        // words[index * lanes + lane] is word number index of the value in lane
+        vector<unsigned int> words;
+    public:
+        BigIntBatch(unsigned long, unsigned short);
+        unsigned long size() const;
+        unsigned short get_width() const;
+        unsigned int * word(unsigned short);
+        const unsigned int * word(unsigned short) const;
+        // Stores a value whose magnitude is below 2^(32 * width - 1) in the lane
+        void set(unsigned long, const BigInt&);
+        BigInt get(unsigned long) const;
+    };
+
+    // The last argument is the number of threads to use. 0 picks one automatically from the batch size.
+    void batch_add(const BigIntBatch&, const BigIntBatch&, BigIntBatch&, unsigned int = 0);
+    void batch_sub(const BigIntBatch&, const BigIntBatch&, BigIntBatch&, unsigned int = 0);
+    void batch_mult(const BigIntBatch&, const BigIntBatch&, BigIntBatch&, unsigned int = 0);
+}
+#endif
@@ -0,0 +1,162 @@
+#ifndef BIGINT_EXPR_DEF
+#define BIGINT_EXPR_DEF
+#include <algorithm>
+#include <concepts>
+#include <span>
+#include <vector>
+#include <math/BigInt.hpp>
+
+using namespace std;
+
+namespace gerryfudd::math {
+    /*
+        Opt-in lazy sums. lazy(a) + b - c builds a small tree of references instead of computing
+        a + b and then (a + b) - c. Converting the tree to a BigInt walks the words once, adding
+        every term's signed contribution to a single running carry, so a chain of n terms costs
+        one pass and one allocation rather than n - 1 of each.
+
+        The tree only refers to its operands. Convert it within the same full expression, or
+        keep the operands alive until it is converted.
+    */
+    class LazyTerm {
+        span<const unsigned int> magnitude;
+        bool negative;
+        // Number of words the value is shifted up by, as in BigInt::shift
+        unsigned short offset;
+    public:
+        LazyTerm(const BigInt& value, unsigned short offset): magnitude{value.magnitude}, negative{value.sign}, offset{offset} {}
+        LazyTerm(const BigInt& value): LazyTerm(value, 0) {}
+        LazyTerm(const BigIntView& value, unsigned short offset): magnitude{value.words, value.length}, negative{value.sign}, offset{offset} {}
+        LazyTerm(const BigIntView& value): LazyTerm(value, 0) {}
+        LazyTerm(const LazyTerm& other, bool negate): magnitude{other.magnitude}, negative{other.negative != negate}, offset{other.offset} {}
+
+        size_t length() const {
+            return magnitude.size() + offset;
+        }
+
+        long word(size_t index) const {
+            if (index < offset || index >= length()) {
+                return 0;
+            }
+            long value = magnitude[index - offset];
+            return negative ? -value : value;
+        }
+
+        LazyTerm operator- () const {
+            return LazyTerm(*this, true);
+        }
+
+        operator BigInt() const;
+    };
+
+    template <class Left, class Right, bool Subtract>
+    class LazySum {
+        Left left;
+        Right right;
+    public:
+        LazySum(const Left& left, const Right& right): left{left}, right{right} {}
+
+        size_t length() const {
+            return max(left.length(), right.length());
+        }
+
+        long word(size_t index) const {
+            return Subtract ? left.word(index) - right.word(index) : left.word(index) + right.word(index);
+        }
+
+        operator BigInt() const;
+    };
+
+    template <class T>
+    concept lazy_big_int = requires(const T& expression, size_t index) {
+        { expression.length() } -> same_as<size_t>;
+        { expression.word(index) } -> same_as<long>;
+    };
+
+    inline LazyTerm lazy(const BigInt& value) {
+        return LazyTerm(value);
+    }
+
+    inline LazyTerm lazy(const BigIntView& value) {
+        return LazyTerm(value);
+    }
+
+    // The value times 2^(32 * offset), without copying it the way BigInt::shift does
+    inline LazyTerm lazy(const BigInt& value, unsigned short offset) {
+        return LazyTerm(value, offset);
+    }
+
+    inline LazyTerm lazy(const BigIntView& value, unsigned short offset) {
+        return LazyTerm(value, offset);
+    }
+
+    template <lazy_big_int Expression>
+    BigInt evaluate(const Expression& expression) {
+        size_t length = expression.length();
+        vector<unsigned int> result;
+        result.reserve(length + 1);
+
+        // Each word adds up at most one 32 bit value per term, so the carry stays small.
+        long carry = 0, current;
+        for (size_t i = 0; i < length; i++) {
+            current = carry + expression.word(i);
+            result.push_back((unsigned int) current);
+            carry = current >> 32;
+        }
+        result.push_back((unsigned int) carry);
+
+        // A negative final carry means the words hold the value in two's complement.
+        bool sign = carry < 0;
+        if (sign) {
+            unsigned long negation = 1;
+            for (size_t i = 0; i < result.size(); i++) {
+                negation += (unsigned long) ~result[i];
+                result[i] = (unsigned int) negation;
+                negation >>= 32;
+            }
+        }
+        while (result.size() > 0 && result.back() == 0) {
+            result.pop_back();
+        }
+        if (result.size() == 0) {
+            return BigInt();
+        }
+        return BigInt(move(result), sign);
+    }
+
+    inline LazyTerm::operator BigInt() const {
+        return evaluate(*this);
+    }
+
+    template <class Left, class Right, bool Subtract>
+    LazySum<Left, Right, Subtract>::operator BigInt() const {
+        return evaluate(*this);
+    }
+
+    template <class T>
+    concept lazy_operand = lazy_big_int<T> || same_as<T, BigInt> || same_as<T, BigIntView>;
+
+    template <class Left, class Right>
+    concept lazy_operands = (lazy_big_int<Left> || lazy_big_int<Right>) && lazy_operand<Left> && lazy_operand<Right>;
+
+    // A plain BigInt or view next to a lazy expression joins the tree as a term
+    template <class T>
+    auto as_lazy(const T& value) {
+        if constexpr (same_as<T, BigInt> || same_as<T, BigIntView>) {
+            return LazyTerm(value);
+        } else {
+            return value;
+        }
+    }
+
+    template <class Left, class Right> requires lazy_operands<Left, Right>
+    auto operator+ (const Left& left, const Right& right) {
+        return LazySum<decltype(as_lazy(left)), decltype(as_lazy(right)), false>(as_lazy(left), as_lazy(right));
+    }
+
+    template <class Left, class Right> requires lazy_operands<Left, Right>
+    auto operator- (const Left& left, const Right& right) {
+        return LazySum<decltype(as_lazy(left)), decltype(as_lazy(right)), true>(as_lazy(left), as_lazy(right));
+    }
+}
+#endif
@@ -0,0 +1,49 @@
+#ifndef BIGINT_SERIAL_DEF
+#define BIGINT_SERIAL_DEF
+#include <iostream>
+#include <string>
+#include <vector>
+#include <math/BigInt.hpp>
+
+using namespace std;
+
+namespace gerryfudd::math {
+    /*
+        Compact binary formats for BigInt. Everything is little-endian.
+
+        A single value is a 32 bit header, (word count << 1) | sign, followed by its words,
+        least significant first. Zero is the header 0 alone.
+
+        A column file stores many values so that they can be memory mapped and used in place:
+            "BIGC", 32 bit version, 64 bit count
+            64 bit word offsets[count + 1], value i is data[offsets[i]] up to data[offsets[i + 1]]
+            one sign bit per value, padded to a multiple of 8 bytes
+            32 bit data words
+    */
+    void write_binary(ostream&, const BigInt&);
+    BigInt read_binary(istream&);
+    void write_column(ostream&, const vector<BigInt>&);
+
+    /*
+        A column file mapped read-only into memory. Indexing it returns views straight into the
+        mapping, so loading costs nothing until the values are read. The views are valid for as
+        long as this object is.
+    */
+    class MappedBigIntColumn {
+        void *mapping;
+        size_t mapping_length;
+        unsigned long count;
+        const unsigned long *offsets;
+        const unsigned char *signs;
+        const unsigned int *data;
+        unsigned long data_words;
+    public:
+        MappedBigIntColumn(const string&);
+        ~MappedBigIntColumn();
+        MappedBigIntColumn(const MappedBigIntColumn&) = delete;
+        MappedBigIntColumn& operator=(const MappedBigIntColumn&) = delete;
+        unsigned long size() const;
+        BigIntView operator[](unsigned long) const;
+    };
+}
+#endif
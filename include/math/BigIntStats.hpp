@@ -0,0 +1,73 @@
+#ifndef BIGINT_STATS_DEF
+#define BIGINT_STATS_DEF
+#include <array>
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+namespace gerryfudd::math {
+    /*
+        Counters for which BigInt kernels run and how large their operands are, so thresholds can
+        be tuned against real traffic. Build with -DBIGINT_STATS to turn them on; otherwise the
+        BIGINT_STATS_SCOPE markers in BigInt.cpp expand to nothing and every snapshot is zero.
+
+        Each thread counts into its own slots, so recording never contends. A kernel's time
+        includes the kernels it calls: multiply_karatsuba's nanoseconds cover its sub-products,
+        which are also counted under their own tiers.
+    */
+    enum class big_int_tier {
+        add,
+        sub,
+        multiply_by_long,
+        multiply_to_len,
+        multiply_karatsuba
+    };
+    const unsigned short BIG_INT_TIER_COUNT = 5;
+
+    // Bucket i counts operations whose larger operand had between 2^(i-1) and 2^i - 1 words.
+    const unsigned short BIG_INT_SIZE_BUCKETS = 17;
+
+    struct big_int_tier_stats {
+        unsigned long calls;
+        unsigned long nanoseconds;
+        array<unsigned long, BIG_INT_SIZE_BUCKETS> sizes;
+    };
+
+    struct big_int_stats {
+        array<big_int_tier_stats, BIG_INT_TIER_COUNT> tiers;
+        const big_int_tier_stats& operator[] (big_int_tier) const;
+    };
+
+#ifdef BIGINT_STATS
+    constexpr bool big_int_stats_enabled = true;
+#else
+    constexpr bool big_int_stats_enabled = false;
+#endif
+
+    const char *tier_name(big_int_tier);
+
+    // Totals over every thread, including threads that have exited
+    big_int_stats snapshot_big_int_stats();
+    // Only what the calling thread recorded
+    big_int_stats snapshot_thread_big_int_stats();
+    void reset_big_int_stats();
+    // One line per tier that ran: calls, mean time per call and the non-empty size buckets
+    void dump_big_int_stats(ostream&, const big_int_stats&);
+    void dump_big_int_stats(ostream&);
+
+#ifdef BIGINT_STATS
+    class big_int_stats_scope {
+        big_int_tier tier;
+        size_t words;
+        chrono::steady_clock::time_point start;
+    public:
+        big_int_stats_scope(big_int_tier tier, size_t words): tier{tier}, words{words}, start{chrono::steady_clock::now()} {}
+        ~big_int_stats_scope();
+    };
+#define BIGINT_STATS_SCOPE(tier, words) gerryfudd::math::big_int_stats_scope big_int_stats_current_scope(tier, words)
+#else
+#define BIGINT_STATS_SCOPE(tier, words)
+#endif
+}
+#endif
@@ -0,0 +1,146 @@
+#ifndef FIXEDINT_DEF
+#define FIXEDINT_DEF
+#include <array>
+#include <iostream>
+#include <utility>
+#include <exception_utils/enriched_exception.hpp>
+#include <math/BigInt.hpp>
+
+using namespace std;
+
+namespace gerryfudd::math {
+    /*
+        A signed integer with a width known at compile time, e.g. FixedInt<256> for a hash. The
+        words live in a std::array in two's complement, least significant first, so values never
+        allocate and every operation can run in a constant expression. The kernels are the same
+        carry propagation and schoolbook multiplication that BigInt uses, unrolled with index
+        sequences. Like unsigned arithmetic in c++, results wrap modulo 2^Bits.
+    */
+    template <unsigned int Bits>
+    class FixedInt {
+        static_assert(Bits > 0 && Bits % 32 == 0, "FixedInt widths are whole 32 bit words.");
+    public:
+        static constexpr size_t WORDS = Bits / 32;
+    private:
+        array<unsigned int, WORDS> words;
+
+        template <size_t... I>
+        static constexpr FixedInt add(const FixedInt& a, const FixedInt& b, unsigned long carry, index_sequence<I...>) {
+            FixedInt result;
+            ((carry = (unsigned long) a.words[I] + b.words[I] + (carry >> 32), result.words[I] = (unsigned int) carry), ...);
+            return result;
+        }
+
+        template <size_t... I>
+        static constexpr FixedInt complement(const FixedInt& a, index_sequence<I...>) {
+            FixedInt result;
+            ((result.words[I] = ~a.words[I]), ...);
+            return result;
+        }
+
+        // Adds a.words[I] * b into result starting at word I, dropping anything past the top word.
+        template <size_t I, size_t... J>
+        static constexpr void mult_row(const FixedInt& a, const FixedInt& b, FixedInt& result, index_sequence<J...>) {
+            unsigned long current_val = 0;
+            ((current_val = ((unsigned long) a.words[I]) * ((unsigned long) b.words[J])
+                + ((unsigned long) result.words[I + J])
+                + (current_val >> 32),
+              result.words[I + J] = (unsigned int) current_val), ...);
+        }
+
+        template <size_t... I>
+        static constexpr FixedInt mult(const FixedInt& a, const FixedInt& b, index_sequence<I...>) {
+            FixedInt result;
+            (mult_row<I>(a, b, result, make_index_sequence<WORDS - I>{}), ...);
+            return result;
+        }
+
+        template <unsigned int> friend class FixedInt;
+    public:
+        constexpr FixedInt(): words{} {}
+
+        constexpr FixedInt(unsigned int v, bool sign): words{} {
+            words[0] = v;
+            if (sign) {
+                *this = -*this;
+            }
+        }
+
+        constexpr FixedInt(unsigned int v): FixedInt(v, false) {}
+
+        // Throws enriched_exception when the value needs more than Bits bits in two's complement
+        explicit FixedInt(const BigInt& value): words{} {
+            size_t length = value.magnitude.size();
+            while (length > 0 && value.magnitude[length - 1] == 0) {
+                length--;
+            }
+            if (length > WORDS || (length == WORDS && value.magnitude[length - 1] >> 31 != 0)) {
+                throw exception_utils::enriched_exception("Value does not fit in this FixedInt.");
+            }
+            for (size_t i = 0; i < length; i++) {
+                words[i] = value.magnitude[i];
+            }
+            if (value.sign) {
+                *this = -*this;
+            }
+        }
+
+        constexpr bool is_negative() const {
+            return words[WORDS - 1] >> 31 != 0;
+        }
+
+        constexpr unsigned int word(size_t index) const {
+            return words[index];
+        }
+
+        // Sign extends or truncates to another width
+        template <unsigned int OtherBits>
+        constexpr FixedInt<OtherBits> resize() const {
+            FixedInt<OtherBits> result;
+            unsigned int extension = is_negative() ? 0xffffffff : 0;
+            for (size_t i = 0; i < FixedInt<OtherBits>::WORDS; i++) {
+                result.words[i] = i < WORDS ? words[i] : extension;
+            }
+            return result;
+        }
+
+        BigInt to_big_int() const {
+            FixedInt absolute = is_negative() ? -*this : *this;
+            vector<unsigned int> magnitude(absolute.words.begin(), absolute.words.end());
+            while (magnitude.size() > 0 && magnitude.back() == 0) {
+                magnitude.pop_back();
+            }
+            if (magnitude.size() == 0) {
+                return BigInt();
+            }
+            return BigInt(magnitude, is_negative());
+        }
+
+        constexpr FixedInt operator+ (const FixedInt& other) const {
+            return add(*this, other, 0, make_index_sequence<WORDS>{});
+        }
+
+        constexpr FixedInt operator- () const {
+            // ~x + 1
+            return add(complement(*this, make_index_sequence<WORDS>{}), FixedInt(), 1L << 32, make_index_sequence<WORDS>{});
+        }
+
+        constexpr FixedInt operator- (const FixedInt& other) const {
+            // x + ~y + 1
+            return add(*this, complement(other, make_index_sequence<WORDS>{}), 1L << 32, make_index_sequence<WORDS>{});
+        }
+
+        constexpr FixedInt operator* (const FixedInt& other) const {
+            return mult(*this, other, make_index_sequence<WORDS>{});
+        }
+
+        constexpr bool operator== (const FixedInt& other) const {
+            return words == other.words;
+        }
+
+        friend ostream& operator<<(ostream& os, const FixedInt& item) {
+            return os << item.to_big_int();
+        }
+    };
+}
+#endif
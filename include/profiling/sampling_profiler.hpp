@@ -0,0 +1,46 @@
+#ifndef SAMPLING_PROFILER_DEFS
+#define SAMPLING_PROFILER_DEFS
+#include <iostream>
+
+using namespace std;
+
+namespace gerryfudd::profiling {
+    /*
+        A sampling profiler for machines without perf. While it runs, SIGPROF fires every time the
+        process has used another 1/frequency seconds of CPU. The handler only copies the interrupted
+        thread's return addresses into a lock-free ring buffer. A collector thread drains the ring
+        into counts per stack, and frames are only named, through exception_utils::symbol_for, when
+        the profile is written out as folded stacks for flamegraph.pl:
+            main;gerryfudd::test::run_one(...);gerryfudd::math::BigInt::multiply_karatsuba(...) 42
+
+        There is one profiler per process. Samples from every run since the last clear_profile()
+        add up.
+    */
+    const unsigned int DEFAULT_SAMPLE_FREQUENCY = 997;
+
+    // Returns false, and changes nothing, when the profiler is already running.
+    bool start_profiling(unsigned int);
+    bool start_profiling();
+    void stop_profiling();
+    void clear_profile();
+
+    struct profile_totals {
+        unsigned long samples;
+        // Samples lost because the ring was full when the timer fired
+        unsigned long dropped;
+    };
+    profile_totals profile_so_far();
+
+    // One line per distinct stack, outermost frame first, followed by its sample count
+    void write_folded(ostream&);
+
+    // Profiles the enclosing block, unless something else already started the profiler.
+    class profile_scope {
+        bool owner;
+    public:
+        profile_scope(unsigned int);
+        profile_scope();
+        ~profile_scope();
+    };
+}
+#endif
@@ -1,47 +1,41 @@
-#include <sstream>
-#include <execinfo.h>
-#define UNW_LOCAL_ONLY
-#include <libunwind.h>
-#include <cxxabi.h>
+#include <atomic>
 
 #include <exception_utils/enriched_exception.hpp>
+#include <exception_utils/stack_trace.hpp>
 
 using namespace std;
 
 namespace gerryfudd::exception_utils {
-    enriched_exception::enriched_exception(string message): message{message} {
-        stringstream out;
-        unw_cursor_t cursor;
-        unw_context_t context;
-        unw_proc_info_t process;
-
-        // Initialize cursor to current frame for local unwinding.
-        unw_getcontext(&context);
-        unw_init_local(&cursor, &context);
-
-        // Unwind frames one by one, going up the frame stack.
-        while (unw_step(&cursor) > 0) {
-            unw_word_t offset, pc;
-            unw_get_reg(&cursor, UNW_REG_IP, &pc);
-            if (pc == 0) {
-                break;
-            }
-            out << "\n    " << hex << pc << " ";
-
-            char sym[256];
-            if (unw_get_proc_name(&cursor, sym, sizeof(sym), &offset) == 0) {
-                char* print_me = sym;
-                int status;
-                char* demangled = abi::__cxa_demangle(sym, nullptr, nullptr, &status);
-                if (status == 0) {
-                    print_me = demangled;
-                }
-                out << print_me;
-            } else {
-                out << " -- error: unable to obtain symbol name for this frame\n\t";
+    atomic<capture_level> default_level{capture_level::addresses};
+
+    void set_default_capture_level(capture_level level) {
+        default_level.store(level, memory_order_relaxed);
+    }
+
+    capture_level default_capture_level() {
+        return default_level.load(memory_order_relaxed);
+    }
+
+    // Kept out of line, so that skipping this frame and the constructor's lands on the code that threw.
+    __attribute__((noinline)) void enriched_exception::capture(capture_level level) {
+        if (level == capture_level::none) {
+            return;
+        }
+        trace_depth = capture_stack(trace, TRACE_CAPACITY, 2);
+        if (level == capture_level::full) {
+            symbols.reserve(trace_depth);
+            for (unsigned short i = 0; i < trace_depth; i++) {
+                symbols.push_back(symbol_for(trace[i]));
             }
         }
-        stack_trace = out.str();
+    }
+
+    __attribute__((noinline)) enriched_exception::enriched_exception(string message, capture_level level): message{move(message)}, trace_depth{0} {
+        capture(level);
+    }
+
+    __attribute__((noinline)) enriched_exception::enriched_exception(string message): message{move(message)}, trace_depth{0} {
+        capture(default_capture_level());
     }
 
     const char * enriched_exception::what() const _GLIBCXX_TXN_SAFE_DYN _GLIBCXX_NOTHROW {
@@ -49,7 +43,11 @@ namespace gerryfudd::exception_utils {
     }
 
     ostream& operator<<(ostream& out, const enriched_exception& ex) {
-        out << "\n  " << ex.message << ex.stack_trace;
+        out << "\n  " << ex.message;
+        for (unsigned short i = 0; i < ex.trace_depth; i++) {
+            out << "\n    " << hex << ex.trace[i] << dec << " "
+                << (i < ex.symbols.size() ? ex.symbols[i] : symbol_for(ex.trace[i]));
+        }
         return out;
     }
 }
@@ -0,0 +1,68 @@
+#define UNW_LOCAL_ONLY
+#include <libunwind.h>
+#include <cxxabi.h>
+#include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include <exception_utils/stack_trace.hpp>
+
+using namespace std;
+
+namespace gerryfudd::exception_utils {
+    // Deep enough for any trace we print. Frames past this are never recorded.
+    const unsigned short MAX_CAPTURE_DEPTH = 128;
+
+    unsigned short __attribute__((noinline)) capture_stack(uintptr_t *addresses, unsigned short capacity, unsigned short skip) {
+        void *frames[MAX_CAPTURE_DEPTH];
+        // The first frame is this function itself.
+        int wanted = 1 + skip + capacity, depth = unw_backtrace(frames, wanted < MAX_CAPTURE_DEPTH ? wanted : MAX_CAPTURE_DEPTH);
+        unsigned short written = 0;
+        for (int i = 1 + skip; i < depth && written < capacity; i++) {
+            addresses[written++] = (uintptr_t) frames[i];
+        }
+        return written;
+    }
+
+    string look_up(uintptr_t address) {
+        unw_cursor_t cursor;
+        unw_context_t context;
+        unw_word_t offset;
+        char sym[256];
+
+        // Point a local cursor at the address so that libunwind resolves the procedure containing it.
+        // Return addresses point just past the call, so look up the byte before to stay inside the caller.
+        unw_getcontext(&context);
+        unw_init_local(&cursor, &context);
+        if (unw_set_reg(&cursor, UNW_REG_IP, address - 1) != 0 || unw_get_proc_name(&cursor, sym, sizeof(sym), &offset) != 0) {
+            return "-- error: unable to obtain symbol name for this frame";
+        }
+        int status;
+        char* demangled = abi::__cxa_demangle(sym, nullptr, nullptr, &status);
+        if (status != 0) {
+            return sym;
+        }
+        string result = demangled;
+        free(demangled);
+        return result;
+    }
+
+    shared_mutex symbol_cache_lock;
+    unordered_map<uintptr_t, string> symbol_cache;
+
+    string symbol_for(uintptr_t address) {
+        {
+            shared_lock<shared_mutex> reading(symbol_cache_lock);
+            unordered_map<uintptr_t, string>::iterator cached = symbol_cache.find(address);
+            if (cached != symbol_cache.end()) {
+                return cached->second;
+            }
+        }
+        // Resolve outside the lock. Two threads may both look up a new address, which is harmless.
+        string symbol = look_up(address);
+        unique_lock<shared_mutex> writing(symbol_cache_lock);
+        symbol_cache.emplace(address, symbol);
+        return symbol;
+    }
+}
@@ -1,8 +1,12 @@
 #include <algorithm>
 #include <exception>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <exception_utils/enriched_exception.hpp>
 #include <math/BigInt.hpp>
+#include <math/BigIntExpr.hpp>
+#include <math/BigIntStats.hpp>
 
 using namespace std;
 
@@ -43,10 +47,105 @@ namespace gerryfudd::math {
         }
     }
 
-    BigInt::BigInt (vector<unsigned int> magnitude, bool sign):magnitude{magnitude}, sign{sign} {}
+    BigInt::BigInt (vector<unsigned int> magnitude, bool sign):magnitude{std::move(magnitude)}, sign{sign} {}
+
+    BigInt::BigInt (const BigIntView& other): magnitude(other.words, other.words + other.length), sign{other.sign} {}
+
+    BigIntView BigInt::view() const {
+        size_t length = magnitude.size();
+        while (length > 0 && magnitude[length - 1] == 0) {
+            length--;
+        }
+        return {magnitude.data(), length, sign};
+    }
     // ********** END constructors & destructors **********
 
     // ********** BEGIN string **********
+    BigInt BigInt::from_decimal_string(const string& text) {
+        bool sign = text.length() > 0 && text[0] == '-';
+        size_t position = sign ? 1 : 0;
+        if (position == text.length()) {
+            throw exception_utils::enriched_exception("Expected decimal digits, got \"" + text + "\"");
+        }
+        vector<unsigned int> result;
+        // Each block of nine digits needs a little under 30 bits.
+        result.reserve((text.length() - position) * 30 / 9 / 32 + 1);
+        // Consume the digits in blocks of nine, the same base that as_decimal_string uses.
+        size_t block_end = position + (text.length() - position) % 9;
+        if (block_end == position) {
+            block_end += 9;
+        }
+        while (position < text.length()) {
+            unsigned long carry = 0;
+            for (; position < block_end; position++) {
+                if (text[position] < '0' || text[position] > '9') {
+                    throw exception_utils::enriched_exception("Expected decimal digits, got \"" + text + "\"");
+                }
+                carry = carry * 10 + (text[position] - '0');
+            }
+            // result = result * 10^9 + block
+            for (int i = 0; i < result.size(); i++) {
+                carry += ((unsigned long) result[i]) * decimal_conversion_base;
+                result[i] = (unsigned int) carry;
+                carry >>= 32;
+            }
+            if (carry > 0) {
+                result.push_back((unsigned int) carry);
+            }
+            block_end += 9;
+        }
+        if (result.size() == 0) {
+            return BigInt();
+        }
+        return BigInt(std::move(result), sign);
+    }
+
+    BigInt BigInt::from_hex_string(const string& text) {
+        bool sign = text.length() > 0 && text[0] == '-';
+        size_t first_digit = sign ? 1 : 0;
+        if (text.compare(first_digit, 2, "0x") == 0) {
+            first_digit += 2;
+        }
+        if (first_digit == text.length()) {
+            throw exception_utils::enriched_exception("Expected hex digits, got \"" + text + "\"");
+        }
+        vector<unsigned int> result;
+        result.reserve((text.length() - first_digit + 7) / 8);
+        unsigned int block = 0;
+        unsigned short shift_by = 0;
+        // Walk from the least significant digit, eight digits per block.
+        for (size_t position = text.length(); position > first_digit; position--) {
+            char c = text[position - 1];
+            unsigned int digit;
+            if (c >= '0' && c <= '9') {
+                digit = c - '0';
+            } else if (c >= 'a' && c <= 'f') {
+                digit = c - 'a' + 10;
+            } else if (c >= 'A' && c <= 'F') {
+                digit = c - 'A' + 10;
+            } else {
+                throw exception_utils::enriched_exception("Expected hex digits, got \"" + text + "\"");
+            }
+            block |= digit << shift_by;
+            shift_by += 4;
+            if (shift_by == 32) {
+                result.push_back(block);
+                block = 0;
+                shift_by = 0;
+            }
+        }
+        if (shift_by > 0) {
+            result.push_back(block);
+        }
+        while (result.size() > 0 && result.back() == 0) {
+            result.pop_back();
+        }
+        if (result.size() == 0) {
+            return BigInt();
+        }
+        return BigInt(std::move(result), sign);
+    }
+
     string BigInt::as_decimal_string() const {
         if (magnitude.size() == 0) {
             return "0";
@@ -131,6 +230,54 @@ namespace gerryfudd::math {
 
         return os;
     }
+
+    // Words either side of the first difference that describe_difference shows
+    const unsigned short DIFFERENCE_WINDOW = 2;
+
+    void describe_word_window(ostream& os, const char *label, span<const unsigned int> words, bool sign, size_t from, size_t to, size_t marked) {
+        os << endl << "  " << label << words.size() << " words, " << (sign ? "negative" : "positive");
+        if (from > to) {
+            return;
+        }
+        os << ", words " << to << ".." << from << ":";
+        ios_base::fmtflags flags = os.flags();
+        char fill = os.fill('0');
+        for (size_t i = to + 1; i-- > from;) {
+            os << (i == marked ? " [" : " ");
+            if (i < words.size()) {
+                os << "0x" << hex << setw(8) << words[i];
+            } else {
+                os << "----------";
+            }
+            os << (i == marked ? "]" : "");
+        }
+        os.flags(flags);
+        os.fill(fill);
+    }
+
+    void describe_difference(ostream& os, const BigInt& actual, const BigInt& expected) {
+        size_t length = max(actual.magnitude.size(), expected.magnitude.size());
+        size_t first = 0;
+        while (first < actual.magnitude.size() && first < expected.magnitude.size()
+            && actual.magnitude[first] == expected.magnitude[first]) {
+            first++;
+        }
+        if (first == length) {
+            os << "BigInt values have the same words but differ in sign.";
+        } else {
+            os << "BigInt values differ from word " << first << " (word 0 is least significant).";
+        }
+
+        // With no words to show, from > to leaves the windows empty.
+        size_t from = 1, to = 0;
+        if (length > 0) {
+            size_t centre = min(first, length - 1);
+            from = centre > DIFFERENCE_WINDOW ? centre - DIFFERENCE_WINDOW : 0;
+            to = min(centre + DIFFERENCE_WINDOW, length - 1);
+        }
+        describe_word_window(os, "actual:   ", actual.magnitude, actual.sign, from, to, first);
+        describe_word_window(os, "expected: ", expected.magnitude, expected.sign, from, to, first);
+    }
     // ********** END string **********
 
     // ********** BEGIN self **********
@@ -186,8 +333,11 @@ namespace gerryfudd::math {
     // ********** END comparison **********
 
     // ********** BEGIN sum **********
-    BigInt BigInt::do_add(vector<unsigned int> other_magnitude) {
+    BigInt BigInt::do_add(span<const unsigned int> other_magnitude) {
+        BIGINT_STATS_SCOPE(big_int_tier::add, max(magnitude.size(), other_magnitude.size()));
         vector<unsigned int> result_magnitude;
+        // Room for a carry out of the top word, so the sum never reallocates.
+        result_magnitude.reserve(max(magnitude.size(), other_magnitude.size()) + 1);
 
         unsigned long current_sum = 0;
 
@@ -205,7 +355,7 @@ namespace gerryfudd::math {
         if ((current_sum >> 32) > 0) {
             result_magnitude.push_back(1);
         }
-        return BigInt(result_magnitude, sign);
+        return BigInt(std::move(result_magnitude), sign);
     }
 
     BigInt BigInt::operator+ (const BigInt& other) {
@@ -214,11 +364,20 @@ namespace gerryfudd::math {
         }
         return do_add(other.magnitude);
     }
+
+    BigInt BigInt::operator+ (const BigIntView& other) {
+        span<const unsigned int> other_magnitude(other.words, other.length);
+        if (sign != other.sign) {
+            return do_sub(other_magnitude);
+        }
+        return do_add(other_magnitude);
+    }
     // ********** END sum **********
 
     // ********** BEGIN difference **********
-    BigInt BigInt::sub_from_larger(vector<unsigned int> larger_magnitude, vector<unsigned int> smaller_magnitude, bool sign) {
+    BigInt BigInt::sub_from_larger(span<const unsigned int> larger_magnitude, span<const unsigned int> smaller_magnitude, bool sign) {
         vector<unsigned int> result_magnitude;
+        result_magnitude.reserve(larger_magnitude.size());
         unsigned int current_place_value;
         unsigned short overflow = 0;
 
@@ -247,11 +406,15 @@ namespace gerryfudd::math {
         while (result_magnitude.back() == 0) {
             result_magnitude.pop_back();
         }
-        return BigInt(result_magnitude, sign);
+        return BigInt(std::move(result_magnitude), sign);
     }
 
-    BigInt BigInt::do_sub(vector<unsigned int> other_magnitude) {
+    BigInt BigInt::do_sub(span<const unsigned int> other_magnitude) {
+        BIGINT_STATS_SCOPE(big_int_tier::sub, max(magnitude.size(), other_magnitude.size()));
         bool this_has_larger_magnitude;
+        if (magnitude.size() == 0 && other_magnitude.size() == 0) {
+            return BigInt();
+        }
         if (magnitude.size() == other_magnitude.size()) {
             unsigned short comparison_index = magnitude.size() - 1;
             while (magnitude[comparison_index] == other_magnitude[comparison_index])
@@ -280,10 +443,19 @@ namespace gerryfudd::math {
         }
         return do_sub(other.magnitude);
     }
+
+    BigInt BigInt::operator- (const BigIntView& other) {
+        span<const unsigned int> other_magnitude(other.words, other.length);
+        if (sign != other.sign) {
+            return do_add(other_magnitude);
+        }
+        return do_sub(other_magnitude);
+    }
     // ********** END difference **********
 
     // ********** BEGIN product **********
-    BigInt BigInt::multiply_to_len(vector<unsigned int> mag_one, vector<unsigned int> mag_two, bool sign) {
+    BigInt BigInt::multiply_to_len(span<const unsigned int> mag_one, span<const unsigned int> mag_two, bool sign) {
+        BIGINT_STATS_SCOPE(big_int_tier::multiply_to_len, max(mag_one.size(), mag_two.size()));
         vector<unsigned int> result_magnitude;
         result_magnitude.resize(mag_one.size() + mag_two.size());
 
@@ -318,7 +490,8 @@ namespace gerryfudd::math {
         return BigInt(result_magnitude, sign);
     }
 
-    BigInt BigInt::multiply_by_long(vector<unsigned int> magnitude, unsigned long val, bool sign) {
+    BigInt BigInt::multiply_by_long(span<const unsigned int> magnitude, unsigned long val, bool sign) {
+        BIGINT_STATS_SCOPE(big_int_tier::multiply_by_long, magnitude.size());
         vector<unsigned int> result;
         unsigned long current, overflow = 0;
 
@@ -355,7 +528,7 @@ namespace gerryfudd::math {
     // const unsigned short BigInt::KARATSUBA_SQUARE_THRESHOLD = 128;
 
     BigInt BigInt::get_upper(const BigInt& other, unsigned short index) {
-        if (other.magnitude.size() <= index + 1) {
+        if (other.magnitude.size() <= index) {
             return BigInt();
         }
 
@@ -377,6 +550,7 @@ namespace gerryfudd::math {
     }
 
     BigInt BigInt::multiply_karatsuba(const BigInt& other) {
+        BIGINT_STATS_SCOPE(big_int_tier::multiply_karatsuba, max(magnitude.size(), other.magnitude.size()));
         unsigned short half_len = ((unsigned int)max(magnitude.size(), other.magnitude.size()) + 1) / 2;
         // tl = this % 2^(32*half_len)
         BigInt tl = BigInt::get_lower(*this, half_len);
@@ -395,29 +569,34 @@ namespace gerryfudd::math {
 
         //           mid = (tu + tl) * (ou + ol) - uu - ll
         //               = tu * ol + tl * ou
-        BigInt mid = (tu + tl) * (ou + ol) - uu - ll;
+        // Both differences are folded into one pass by the lazy sum.
+        BigInt mid = lazy((tu + tl) * (ou + ol)) - uu - ll;
 
         // this * other = (tu*2^(32*half_len) + tl)*(ou*2^(32*half_len) + ol)
         //              = uu*2^(32*half_len*2) + (tu*ol + tl*ou)*2^(32*half_len) + ll
         // return uu.shift(half_len * 2) + (mid - uu - ll).shift(half_len) + ll;
-        return uu.shift(half_len << 1) + mid.shift(half_len) + ll;
+        return lazy(uu, half_len << 1) + lazy(mid, half_len) + ll;
     }
     // ****** END Karitsuba ******
 
+    BigInt BigInt::multiply_below_karatsuba(span<const unsigned int> mag_one, span<const unsigned int> mag_two, bool sign) {
+        if (mag_two.size() == 1) {
+            return BigInt::multiply_by_long(mag_one, mag_two[0], sign);
+        }
+
+        if (mag_one.size() == 1) {
+            return BigInt::multiply_by_long(mag_two, mag_one.front(), sign);
+        }
+
+        return BigInt::multiply_to_len(mag_one, mag_two, sign);
+    }
+
     BigInt BigInt::mult(const BigInt& other, bool is_recursion) {
         if (magnitude.size() == 0 || other.magnitude.size() == 0) {
             return BigInt();
         }
         if (magnitude.size() < KARATSUBA_THRESHOLD || other.magnitude.size() < KARATSUBA_THRESHOLD) {
-            if (other.magnitude.size() == 1) {
-                return BigInt::multiply_by_long(magnitude, other.magnitude[0], sign != other.sign);
-            }
-
-            if (magnitude.size() == 1) {
-                return BigInt::multiply_by_long(other.magnitude, magnitude.front(), sign != other.sign);
-            }
-
-            return BigInt::multiply_to_len(magnitude, other.magnitude, sign != other.sign);
+            return BigInt::multiply_below_karatsuba(magnitude, other.magnitude, sign != other.sign);
         }
         if ((magnitude.size() < TOOM_COOK_THRESHOLD) && (other.magnitude.size() < TOOM_COOK_THRESHOLD)) {
             return multiply_karatsuba(other);
@@ -445,5 +624,16 @@ namespace gerryfudd::math {
     BigInt BigInt::operator* (const BigInt& other) {
         return mult(other, false);
     }
+
+    BigInt BigInt::operator* (const BigIntView& other) {
+        if (magnitude.size() == 0 || other.length == 0) {
+            return BigInt();
+        }
+        if (magnitude.size() < KARATSUBA_THRESHOLD || other.length < KARATSUBA_THRESHOLD) {
+            return BigInt::multiply_below_karatsuba(magnitude, span<const unsigned int>(other.words, other.length), sign != other.sign);
+        }
+        // Karatsuba splits its operands into new BigInts anyway, so one more copy is cheap here.
+        return mult(BigInt(other), false);
+    }
     // ********** END product **********
 }
@@ -0,0 +1,227 @@
+#include <thread>
+#include <exception_utils/enriched_exception.hpp>
+#include <math/BigIntBatch.hpp>
+
+using namespace std;
+
+namespace gerryfudd::math {
+    // Lanes handled together by one pass of a kernel. Small enough that the carries stay in L1.
+    const unsigned long LANE_BLOCK = 256;
+    // Below this many output words the cost of starting threads outweighs the work.
+    const unsigned long PARALLEL_THRESHOLD_WORDS = 1 << 18;
+
+    // ********** BEGIN constructors & accessors **********
+    BigIntBatch::BigIntBatch(unsigned long lanes, unsigned short width): lanes{lanes}, width{width}, words(lanes * width, 0) {
+        if (width == 0) {
+            throw exception_utils::enriched_exception("A BigIntBatch needs at least one word per lane.");
+        }
+    }
+
+    unsigned long BigIntBatch::size() const {
+        return lanes;
+    }
+
+    unsigned short BigIntBatch::get_width() const {
+        return width;
+    }
+
+    unsigned int * BigIntBatch::word(unsigned short index) {
+        return words.data() + index * lanes;
+    }
+
+    const unsigned int * BigIntBatch::word(unsigned short index) const {
+        return words.data() + index * lanes;
+    }
+
+    void BigIntBatch::set(unsigned long lane, const BigInt& value) {
+        size_t length = value.magnitude.size();
+        while (length > 0 && value.magnitude[length - 1] == 0) {
+            length--;
+        }
+        if (length > width || (length == width && value.magnitude[length - 1] >> 31 != 0)) {
+            throw exception_utils::enriched_exception("Value does not fit in the lanes of this BigIntBatch.");
+        }
+        // Two's complement negation is ~x + 1, applied while copying.
+        unsigned long carry = value.sign ? 1 : 0;
+        for (unsigned short i = 0; i < width; i++) {
+            unsigned int current = i < length ? value.magnitude[i] : 0;
+            if (value.sign) {
+                carry += (unsigned long) ~current;
+                current = (unsigned int) carry;
+                carry >>= 32;
+            }
+            word(i)[lane] = current;
+        }
+    }
+
+    BigInt BigIntBatch::get(unsigned long lane) const {
+        bool negative = word(width - 1)[lane] >> 31 != 0;
+        vector<unsigned int> magnitude;
+        unsigned long carry = negative ? 1 : 0;
+        for (unsigned short i = 0; i < width; i++) {
+            unsigned int current = word(i)[lane];
+            if (negative) {
+                carry += (unsigned long) ~current;
+                current = (unsigned int) carry;
+                carry >>= 32;
+            }
+            magnitude.push_back(current);
+        }
+        while (magnitude.size() > 0 && magnitude.back() == 0) {
+            magnitude.pop_back();
+        }
+        if (magnitude.size() == 0) {
+            return BigInt();
+        }
+        return BigInt(magnitude, negative);
+    }
+    // ********** END constructors & accessors **********
+
+    // ********** BEGIN lane blocks **********
+    /*
+        The view of one operand over a block of lanes. Words past the operand's width are its
+        sign extension, which differs per lane, so they are materialized once per block.
+    */
+    struct operand_block {
+        const BigIntBatch& batch;
+        unsigned long begin;
+        unsigned int extension[LANE_BLOCK];
+        bool any_negative;
+
+        operand_block(const BigIntBatch& batch, unsigned long begin, unsigned long count): batch{batch}, begin{begin}, any_negative{false} {
+            const unsigned int *top = batch.word(batch.get_width() - 1) + begin;
+            for (unsigned long l = 0; l < count; l++) {
+                extension[l] = (unsigned int) (((int) top[l]) >> 31);
+                any_negative = any_negative || extension[l] != 0;
+            }
+        }
+
+        const unsigned int * word(unsigned short index) const {
+            return index < batch.get_width() ? batch.word(index) + begin : extension;
+        }
+
+        // Past this many words every lane's value is only sign extension
+        unsigned short significant_words(unsigned short limit) const {
+            return any_negative || batch.get_width() > limit ? limit : batch.get_width();
+        }
+    };
+
+    void check_lanes(const BigIntBatch& a, const BigIntBatch& b, const BigIntBatch& result) {
+        if (a.size() != b.size() || a.size() != result.size()) {
+            throw exception_utils::enriched_exception("Every BigIntBatch in a batch operation needs the same number of lanes.");
+        }
+    }
+
+    /*
+        Splits the lanes into blocks and hands contiguous runs of blocks to each thread.
+        kernel(begin, count) must only touch lanes [begin, begin + count).
+    */
+    template <class Kernel>
+    void for_each_block(unsigned long lanes, unsigned short width, unsigned int threads, Kernel kernel) {
+        unsigned long blocks = (lanes + LANE_BLOCK - 1) / LANE_BLOCK;
+        if (threads == 0) {
+            threads = lanes * width < PARALLEL_THRESHOLD_WORDS ? 1 : thread::hardware_concurrency();
+        }
+        if (threads > blocks) {
+            threads = blocks;
+        }
+
+        auto run_blocks = [lanes, kernel](unsigned long first_block, unsigned long last_block) {
+            for (unsigned long block = first_block; block < last_block; block++) {
+                unsigned long begin = block * LANE_BLOCK;
+                kernel(begin, min(LANE_BLOCK, lanes - begin));
+            }
+        };
+
+        if (threads <= 1) {
+            run_blocks(0, blocks);
+            return;
+        }
+        vector<thread> workers;
+        for (unsigned int t = 0; t < threads; t++) {
+            workers.emplace_back(run_blocks, blocks * t / threads, blocks * (t + 1) / threads);
+        }
+        for (vector<thread>::iterator worker = workers.begin(); worker != workers.end(); worker++) {
+            worker->join();
+        }
+    }
+    // ********** END lane blocks **********
+
+    // ********** BEGIN sum & difference **********
+    void batch_add(const BigIntBatch& a, const BigIntBatch& b, BigIntBatch& result, unsigned int threads) {
+        check_lanes(a, b, result);
+        for_each_block(result.size(), result.get_width(), threads, [&a, &b, &result](unsigned long begin, unsigned long count) {
+            operand_block x(a, begin, count), y(b, begin, count);
+            unsigned int carry[LANE_BLOCK] = {0};
+            for (unsigned short i = 0; i < result.get_width(); i++) {
+                const unsigned int *xi = x.word(i), *yi = y.word(i);
+                unsigned int *ri = result.word(i) + begin;
+                for (unsigned long l = 0; l < count; l++) {
+                    unsigned long current_sum = (unsigned long) xi[l] + yi[l] + carry[l];
+                    ri[l] = (unsigned int) current_sum;
+                    carry[l] = current_sum >> 32;
+                }
+            }
+        });
+    }
+
+    void batch_sub(const BigIntBatch& a, const BigIntBatch& b, BigIntBatch& result, unsigned int threads) {
+        check_lanes(a, b, result);
+        for_each_block(result.size(), result.get_width(), threads, [&a, &b, &result](unsigned long begin, unsigned long count) {
+            operand_block x(a, begin, count), y(b, begin, count);
+            unsigned int borrow[LANE_BLOCK] = {0};
+            for (unsigned short i = 0; i < result.get_width(); i++) {
+                const unsigned int *xi = x.word(i), *yi = y.word(i);
+                unsigned int *ri = result.word(i) + begin;
+                for (unsigned long l = 0; l < count; l++) {
+                    // A negative difference wraps around and sets the top bit
+                    unsigned long current_difference = (unsigned long) xi[l] - yi[l] - borrow[l];
+                    ri[l] = (unsigned int) current_difference;
+                    borrow[l] = current_difference >> 63;
+                }
+            }
+        });
+    }
+    // ********** END sum & difference **********
+
+    // ********** BEGIN product **********
+    void batch_mult(const BigIntBatch& a, const BigIntBatch& b, BigIntBatch& result, unsigned int threads) {
+        check_lanes(a, b, result);
+        if (&a == &result || &b == &result) {
+            throw exception_utils::enriched_exception("batch_mult cannot write its result over one of its operands.");
+        }
+        for_each_block(result.size(), result.get_width(), threads, [&a, &b, &result](unsigned long begin, unsigned long count) {
+            operand_block x(a, begin, count), y(b, begin, count);
+            unsigned short width = result.get_width();
+            for (unsigned short i = 0; i < width; i++) {
+                unsigned int *ri = result.word(i) + begin;
+                for (unsigned long l = 0; l < count; l++) {
+                    ri[l] = 0;
+                }
+            }
+            // Schoolbook multiplication as in multiply_to_len, truncated to the result width.
+            unsigned short x_words = x.significant_words(width);
+            for (unsigned short i = 0; i < x_words; i++) {
+                const unsigned int *xi = x.word(i);
+                unsigned int carry[LANE_BLOCK] = {0};
+                unsigned short y_words = y.significant_words(width - i);
+                for (unsigned short j = 0; j < y_words; j++) {
+                    const unsigned int *yj = y.word(j);
+                    unsigned int *rij = result.word(i + j) + begin;
+                    for (unsigned long l = 0; l < count; l++) {
+                        unsigned long current_val = (unsigned long) xi[l] * yj[l] + rij[l] + carry[l];
+                        rij[l] = (unsigned int) current_val;
+                        carry[l] = current_val >> 32;
+                    }
+                }
+                if (i + y_words < width) {
+                    unsigned int *overflow = result.word(i + y_words) + begin;
+                    for (unsigned long l = 0; l < count; l++) {
+                        overflow[l] = carry[l];
+                    }
+                }
+            }
+        });
+    }
+    // ********** END product **********
+}
@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <bit>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <exception_utils/enriched_exception.hpp>
+#include <math/BigIntSerial.hpp>
+
+using namespace std;
+
+namespace gerryfudd::math {
+    const char COLUMN_MAGIC[] = {'B', 'I', 'G', 'C'};
+    const unsigned int COLUMN_VERSION = 1;
+    const size_t COLUMN_HEADER_BYTES = 16;
+    // read_binary grows a value by at most this many words per read, so a corrupt header cannot
+    // make it allocate more than the input actually holds.
+    const size_t READ_CHUNK_WORDS = 1 << 16;
+
+    // ********** BEGIN byte order **********
+    template <class T>
+    T little_endian(T value) {
+        if constexpr (endian::native == endian::little) {
+            return value;
+        } else {
+            T result = 0;
+            for (size_t i = 0; i < sizeof(T); i++) {
+                result = (result << 8) | (value & 0xff);
+                value >>= 8;
+            }
+            return result;
+        }
+    }
+
+    template <class T>
+    void write_little_endian(ostream& out, T value) {
+        value = little_endian(value);
+        out.write((const char *) &value, sizeof(T));
+    }
+
+    void write_words(ostream& out, const BigIntView& value) {
+        if constexpr (endian::native == endian::little) {
+            out.write((const char *) value.words, value.length * sizeof(unsigned int));
+        } else {
+            for (size_t i = 0; i < value.length; i++) {
+                write_little_endian(out, value.words[i]);
+            }
+        }
+    }
+    // ********** END byte order **********
+
+    // ********** BEGIN single values **********
+    void write_binary(ostream& out, const BigInt& value) {
+        BigIntView view = value.view();
+        if (view.length > 0x7fffffff) {
+            throw exception_utils::enriched_exception("Value is too long for the binary format.");
+        }
+        write_little_endian(out, (unsigned int) (view.length << 1 | (view.length > 0 && view.sign)));
+        write_words(out, view);
+    }
+
+    BigInt read_binary(istream& in) {
+        unsigned int header;
+        if (!in.read((char *) &header, sizeof(header))) {
+            throw exception_utils::enriched_exception("Unexpected end of input while reading a BigInt header.");
+        }
+        header = little_endian(header);
+        size_t length = header >> 1;
+        if (length == 0) {
+            return BigInt();
+        }
+        vector<unsigned int> magnitude;
+        while (magnitude.size() < length) {
+            size_t read = magnitude.size(), chunk = min(length - read, READ_CHUNK_WORDS);
+            magnitude.resize(read + chunk);
+            if (!in.read((char *) (magnitude.data() + read), chunk * sizeof(unsigned int))) {
+                throw exception_utils::enriched_exception("Unexpected end of input while reading BigInt words.");
+            }
+        }
+        if constexpr (endian::native != endian::little) {
+            for (size_t i = 0; i < magnitude.size(); i++) {
+                magnitude[i] = little_endian(magnitude[i]);
+            }
+        }
+        return BigInt(move(magnitude), (header & 1) != 0);
+    }
+    // ********** END single values **********
+
+    // ********** BEGIN columns **********
+    unsigned long sign_bytes(unsigned long count) {
+        return (count + 63) / 64 * 8;
+    }
+
+    void write_column(ostream& out, const vector<BigInt>& values) {
+        vector<BigIntView> views;
+        views.reserve(values.size());
+        for (vector<BigInt>::const_iterator value = values.begin(); value != values.end(); value++) {
+            views.push_back(value->view());
+        }
+
+        out.write(COLUMN_MAGIC, sizeof(COLUMN_MAGIC));
+        write_little_endian(out, COLUMN_VERSION);
+        write_little_endian(out, (unsigned long) views.size());
+
+        unsigned long offset = 0;
+        write_little_endian(out, offset);
+        for (vector<BigIntView>::iterator view = views.begin(); view != views.end(); view++) {
+            offset += view->length;
+            write_little_endian(out, offset);
+        }
+
+        vector<unsigned char> signs(sign_bytes(views.size()), 0);
+        for (unsigned long i = 0; i < views.size(); i++) {
+            if (views[i].sign && views[i].length > 0) {
+                signs[i / 8] |= 1 << (i % 8);
+            }
+        }
+        out.write((const char *) signs.data(), signs.size());
+
+        for (vector<BigIntView>::iterator view = views.begin(); view != views.end(); view++) {
+            write_words(out, *view);
+        }
+    }
+
+    MappedBigIntColumn::MappedBigIntColumn(const string& path): mapping{nullptr}, mapping_length{0} {
+        if constexpr (endian::native != endian::little) {
+            throw exception_utils::enriched_exception("Column files can only be mapped in place on little-endian machines.");
+        }
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw exception_utils::enriched_exception("Unable to open column file " + path);
+        }
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0 || file_stat.st_size < COLUMN_HEADER_BYTES) {
+            close(fd);
+            throw exception_utils::enriched_exception("Column file " + path + " is too short for its header.");
+        }
+        mapping_length = file_stat.st_size;
+        mapping = mmap(nullptr, mapping_length, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping stays valid after the descriptor is closed.
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            mapping = nullptr;
+            throw exception_utils::enriched_exception("Unable to map column file " + path);
+        }
+
+        const char *bytes = (const char *) mapping;
+        unsigned int version = *(const unsigned int *) (bytes + 4);
+        count = *(const unsigned long *) (bytes + 8);
+        bool valid = string(bytes, 4) == string(COLUMN_MAGIC, 4) && version == COLUMN_VERSION;
+        // Checked piece by piece so that a corrupt count cannot overflow the size arithmetic.
+        size_t data_start = COLUMN_HEADER_BYTES;
+        valid = valid && count < mapping_length / 8;
+        if (valid) {
+            offsets = (const unsigned long *) (bytes + data_start);
+            data_start += (count + 1) * 8;
+            signs = (const unsigned char *) (bytes + data_start);
+            data_start += sign_bytes(count);
+            valid = data_start <= mapping_length;
+        }
+        if (valid) {
+            data = (const unsigned int *) (bytes + data_start);
+            data_words = (mapping_length - data_start) / sizeof(unsigned int);
+            valid = offsets[count] <= data_words;
+        }
+        if (!valid) {
+            munmap(mapping, mapping_length);
+            mapping = nullptr;
+            throw exception_utils::enriched_exception("Column file " + path + " is not a valid BigInt column.");
+        }
+    }
+
+    MappedBigIntColumn::~MappedBigIntColumn() {
+        if (mapping != nullptr) {
+            munmap(mapping, mapping_length);
+        }
+    }
+
+    unsigned long MappedBigIntColumn::size() const {
+        return count;
+    }
+
+    BigIntView MappedBigIntColumn::operator[](unsigned long index) const {
+        if (index >= count || offsets[index] > offsets[index + 1] || offsets[index + 1] > data_words) {
+            throw exception_utils::enriched_exception("Column index out of range or column file corrupt.");
+        }
+        return {data + offsets[index], offsets[index + 1] - offsets[index], (signs[index / 8] >> (index % 8) & 1) != 0};
+    }
+    // ********** END columns **********
+}
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+#include <math/BigIntStats.hpp>
+
+using namespace std;
+
+namespace gerryfudd::math {
+    const big_int_tier_stats& big_int_stats::operator[] (big_int_tier tier) const {
+        return tiers[(unsigned short) tier];
+    }
+
+    const char *tier_name(big_int_tier tier) {
+        switch (tier) {
+            case big_int_tier::add: return "add";
+            case big_int_tier::sub: return "sub";
+            case big_int_tier::multiply_by_long: return "multiply_by_long";
+            case big_int_tier::multiply_to_len: return "multiply_to_len";
+            case big_int_tier::multiply_karatsuba: return "multiply_karatsuba";
+        }
+        return "unknown";
+    }
+
+#ifdef BIGINT_STATS
+    // ********** BEGIN per thread counters **********
+    /*
+        Only the owning thread adds to its counters. They are atomic so that a snapshot from
+        another thread reads whole values, and relaxed because nothing else is ordered by them.
+    */
+    struct thread_counters {
+        atomic<unsigned long> calls[BIG_INT_TIER_COUNT];
+        atomic<unsigned long> nanoseconds[BIG_INT_TIER_COUNT];
+        atomic<unsigned long> sizes[BIG_INT_TIER_COUNT][BIG_INT_SIZE_BUCKETS];
+        thread_counters();
+        ~thread_counters();
+        void add_to(big_int_stats&) const;
+        void clear();
+    };
+
+    mutex registry_lock;
+    vector<thread_counters*> live_counters;
+    // What exited threads recorded, folded in when they exit
+    big_int_stats retired_stats{};
+
+    thread_counters::thread_counters() {
+        clear();
+        lock_guard<mutex> guard(registry_lock);
+        live_counters.push_back(this);
+    }
+
+    thread_counters::~thread_counters() {
+        lock_guard<mutex> guard(registry_lock);
+        add_to(retired_stats);
+        live_counters.erase(find(live_counters.begin(), live_counters.end(), this));
+    }
+
+    void thread_counters::add_to(big_int_stats& stats) const {
+        for (unsigned short tier = 0; tier < BIG_INT_TIER_COUNT; tier++) {
+            stats.tiers[tier].calls += calls[tier].load(memory_order_relaxed);
+            stats.tiers[tier].nanoseconds += nanoseconds[tier].load(memory_order_relaxed);
+            for (unsigned short bucket = 0; bucket < BIG_INT_SIZE_BUCKETS; bucket++) {
+                stats.tiers[tier].sizes[bucket] += sizes[tier][bucket].load(memory_order_relaxed);
+            }
+        }
+    }
+
+    void thread_counters::clear() {
+        for (unsigned short tier = 0; tier < BIG_INT_TIER_COUNT; tier++) {
+            calls[tier].store(0, memory_order_relaxed);
+            nanoseconds[tier].store(0, memory_order_relaxed);
+            for (unsigned short bucket = 0; bucket < BIG_INT_SIZE_BUCKETS; bucket++) {
+                sizes[tier][bucket].store(0, memory_order_relaxed);
+            }
+        }
+    }
+
+    thread_local thread_counters counters;
+
+    big_int_stats_scope::~big_int_stats_scope() {
+        unsigned long elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+        unsigned short index = (unsigned short) tier;
+        unsigned short bucket = min<size_t>(bit_width(words), BIG_INT_SIZE_BUCKETS - 1);
+        counters.calls[index].fetch_add(1, memory_order_relaxed);
+        counters.nanoseconds[index].fetch_add(elapsed, memory_order_relaxed);
+        counters.sizes[index][bucket].fetch_add(1, memory_order_relaxed);
+    }
+    // ********** END per thread counters **********
+
+    big_int_stats snapshot_big_int_stats() {
+        lock_guard<mutex> guard(registry_lock);
+        big_int_stats result = retired_stats;
+        for (thread_counters *thread : live_counters) {
+            thread->add_to(result);
+        }
+        return result;
+    }
+
+    big_int_stats snapshot_thread_big_int_stats() {
+        big_int_stats result{};
+        counters.add_to(result);
+        return result;
+    }
+
+    void reset_big_int_stats() {
+        lock_guard<mutex> guard(registry_lock);
+        retired_stats = big_int_stats{};
+        for (thread_counters *thread : live_counters) {
+            thread->clear();
+        }
+    }
+#else
+    big_int_stats snapshot_big_int_stats() {
+        return big_int_stats{};
+    }
+
+    big_int_stats snapshot_thread_big_int_stats() {
+        return big_int_stats{};
+    }
+
+    void reset_big_int_stats() {}
+#endif
+
+    void dump_big_int_stats(ostream& out, const big_int_stats& stats) {
+        for (unsigned short tier = 0; tier < BIG_INT_TIER_COUNT; tier++) {
+            const big_int_tier_stats& current = stats.tiers[tier];
+            if (current.calls == 0) {
+                continue;
+            }
+            out << left << setw(20) << tier_name((big_int_tier) tier) << right
+                << setw(12) << current.calls << " calls"
+                << setw(12) << fixed << setprecision(1) << (double) current.nanoseconds / current.calls << " ns/call"
+                << "  words:";
+            for (unsigned short bucket = 0; bucket < BIG_INT_SIZE_BUCKETS; bucket++) {
+                if (current.sizes[bucket] == 0) {
+                    continue;
+                }
+                // Bucket 0 only holds empty operands.
+                unsigned long low = bucket == 0 ? 0 : 1UL << (bucket - 1);
+                out << " [" << low << "," << (1UL << bucket) - 1 << "]=" << current.sizes[bucket];
+            }
+            out << endl;
+        }
+    }
+
+    void dump_big_int_stats(ostream& out) {
+        dump_big_int_stats(out, snapshot_big_int_stats());
+    }
+}
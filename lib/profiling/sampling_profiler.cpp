@@ -0,0 +1,197 @@
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <map>
+#include <mutex>
+#include <string>
+#include <sys/time.h>
+#include <thread>
+#include <vector>
+
+#include <exception_utils/stack_trace.hpp>
+#include <profiling/sampling_profiler.hpp>
+
+using namespace std;
+
+namespace gerryfudd::profiling {
+    const unsigned short SAMPLE_DEPTH = 64;
+    // A power of two, so positions map to slots with a mask
+    const unsigned long RING_CAPACITY = 1024;
+    const chrono::milliseconds COLLECT_INTERVAL(50);
+
+    /*
+        A bounded multi-producer queue. Each slot's sequence says whose turn it is: a writer may
+        claim position p when its slot holds p and publishes p + 1 once the stack is in place,
+        and the reader hands the slot back for position p + RING_CAPACITY after copying it.
+    */
+    struct sample_slot {
+        atomic<unsigned long> sequence;
+        unsigned short depth;
+        uintptr_t addresses[SAMPLE_DEPTH];
+    };
+
+    sample_slot ring[RING_CAPACITY];
+    atomic<unsigned long> write_position{0};
+    unsigned long read_position = 0;
+    atomic<unsigned long> dropped_samples{0};
+    atomic<bool> sampling{false};
+
+    // Everything below is only touched outside the signal handler, under profile_lock.
+    mutex profile_lock;
+    map<vector<uintptr_t>, unsigned long> stack_counts;
+    unsigned long sample_count = 0;
+    bool running = false;
+    bool handler_installed = false;
+    thread collector;
+    condition_variable collector_wake;
+
+    void on_sigprof(int) {
+        if (!sampling.load(memory_order_relaxed)) {
+            return;
+        }
+        int saved_errno = errno;
+        unsigned long position = write_position.load(memory_order_relaxed);
+        sample_slot *slot;
+        while (true) {
+            slot = &ring[position & (RING_CAPACITY - 1)];
+            unsigned long sequence = slot->sequence.load(memory_order_acquire);
+            if (sequence == position) {
+                if (write_position.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                    break;
+                }
+            } else if (sequence < position) {
+                dropped_samples.fetch_add(1, memory_order_relaxed);
+                errno = saved_errno;
+                return;
+            } else {
+                position = write_position.load(memory_order_relaxed);
+            }
+        }
+        // Skip this handler and the kernel's signal trampoline, so the stack starts at the interrupted code.
+        slot->depth = exception_utils::capture_stack(slot->addresses, SAMPLE_DEPTH, 2);
+        slot->sequence.store(position + 1, memory_order_release);
+        errno = saved_errno;
+    }
+
+    // Callers hold profile_lock.
+    void drain() {
+        while (true) {
+            sample_slot& slot = ring[read_position & (RING_CAPACITY - 1)];
+            if (slot.sequence.load(memory_order_acquire) != read_position + 1) {
+                return;
+            }
+            stack_counts[vector<uintptr_t>(slot.addresses, slot.addresses + slot.depth)]++;
+            sample_count++;
+            slot.sequence.store(read_position + RING_CAPACITY, memory_order_release);
+            read_position++;
+        }
+    }
+
+    void collect() {
+        unique_lock<mutex> guard(profile_lock);
+        while (running) {
+            drain();
+            collector_wake.wait_for(guard, COLLECT_INTERVAL);
+        }
+    }
+
+    void set_timer(unsigned int frequency) {
+        itimerval timer = {};
+        if (frequency > 0) {
+            timer.it_interval.tv_usec = frequency > 1000000 ? 1 : 1000000 / frequency;
+            timer.it_value = timer.it_interval;
+        }
+        setitimer(ITIMER_PROF, &timer, nullptr);
+    }
+
+    bool start_profiling(unsigned int frequency) {
+        lock_guard<mutex> guard(profile_lock);
+        if (running) {
+            return false;
+        }
+        if (!handler_installed) {
+            for (unsigned long i = 0; i < RING_CAPACITY; i++) {
+                ring[i].sequence.store(i, memory_order_relaxed);
+            }
+            // The handler stays installed for good. A SIGPROF still pending after stop_profiling
+            // would otherwise hit the default action, which ends the process.
+            struct sigaction action = {};
+            action.sa_handler = on_sigprof;
+            action.sa_flags = SA_RESTART;
+            sigemptyset(&action.sa_mask);
+            sigaction(SIGPROF, &action, nullptr);
+            handler_installed = true;
+        }
+        running = true;
+        collector = thread(collect);
+        sampling.store(true, memory_order_relaxed);
+        set_timer(frequency);
+        return true;
+    }
+
+    bool start_profiling() {
+        return start_profiling(DEFAULT_SAMPLE_FREQUENCY);
+    }
+
+    void stop_profiling() {
+        {
+            lock_guard<mutex> guard(profile_lock);
+            if (!running) {
+                return;
+            }
+            set_timer(0);
+            sampling.store(false, memory_order_relaxed);
+            running = false;
+        }
+        collector_wake.notify_all();
+        collector.join();
+        lock_guard<mutex> guard(profile_lock);
+        drain();
+    }
+
+    void clear_profile() {
+        lock_guard<mutex> guard(profile_lock);
+        drain();
+        stack_counts.clear();
+        sample_count = 0;
+        dropped_samples.store(0, memory_order_relaxed);
+    }
+
+    profile_totals profile_so_far() {
+        lock_guard<mutex> guard(profile_lock);
+        drain();
+        return {sample_count, dropped_samples.load(memory_order_relaxed)};
+    }
+
+    void write_folded(ostream& out) {
+        map<string, unsigned long> folded;
+        {
+            lock_guard<mutex> guard(profile_lock);
+            drain();
+            // Different addresses in the same functions fold into one line.
+            for (map<vector<uintptr_t>, unsigned long>::iterator stack = stack_counts.begin(); stack != stack_counts.end(); stack++) {
+                string line;
+                for (vector<uintptr_t>::const_reverse_iterator frame = stack->first.rbegin(); frame != stack->first.rend(); frame++) {
+                    if (!line.empty()) {
+                        line += ';';
+                    }
+                    line += exception_utils::symbol_for(*frame);
+                }
+                folded[line] += stack->second;
+            }
+        }
+        for (map<string, unsigned long>::iterator stack = folded.begin(); stack != folded.end(); stack++) {
+            out << stack->first << " " << stack->second << endl;
+        }
+    }
+
+    profile_scope::profile_scope(unsigned int frequency): owner{start_profiling(frequency)} {}
+    profile_scope::profile_scope(): profile_scope(DEFAULT_SAMPLE_FREQUENCY) {}
+    profile_scope::~profile_scope() {
+        if (owner) {
+            stop_profiling();
+        }
+    }
+}
@@ -1,8 +1,11 @@
 #ifndef AGGREGATOR_TYPE
 #define AGGREGATOR_TYPE
 
+#include <Benchmark.hpp>
+#include <MemoryTracking.hpp>
 #include <Test.hpp>
 #include <exception>
+#include <string>
 #include <vector>
 
 namespace gerryfudd::test {
@@ -10,14 +13,57 @@ namespace gerryfudd::test {
     std::string message;
   public:
     AggregationException(const char *);
+    AggregationException(std::string);
     const char* what() const _GLIBCXX_TXN_SAFE_DYN _GLIBCXX_NOTHROW override;
   };
 
+  /*
+    Command line options for the test binary.
+      --jobs=N      run N tests at a time, 0 for one per core
+      --fork        run tests in worker processes so that a crash only fails the test that crashed
+      --shard=i/n   only run every nth test starting with the ith, for splitting a suite across machines
+      --slowest=N   list the N slowest tests after the run, 0 for none
+      --timings=F   write how long each test took to the JSON file F
+      --baseline=F  fail the run when a test takes more than --max-regression=R times (default 2)
+                    as long as it did in the timings file F
+      --bench       run the BENCHMARKs instead of the tests, --bench=S for those whose name contains S
+      --profile=F   sample the run with the profiler and write folded stacks to F, not with --fork
+  */
+  struct RunOptions {
+    unsigned int jobs;
+    bool fork_workers;
+    unsigned int shard_index;
+    unsigned int shard_count;
+    unsigned int slowest;
+    std::string timings_path;
+    std::string baseline_path;
+    double max_regression;
+    bool benchmarks;
+    std::string benchmark_filter;
+    std::string profile_path;
+    RunOptions();
+    static RunOptions parse(int, char **);
+  };
+
+  struct TestResult {
+    bool complete;
+    bool failed;
+    double elapsed_ms;
+    memory_usage memory;
+    std::string info;
+    std::string failure;
+  };
+
   class Aggregator {
     static std::vector<Test> tests;
+    static std::vector<Benchmark> benchmarks;
+    static int run_benchmarks(const std::string&);
+    static int run_selected(const RunOptions&);
   public:
     static void add(Test);
-    static int run_all();
+    static void add(Benchmark);
+    static int run_all(int, char **);
+    static int run_all(const RunOptions&);
   };
 }
 #endif
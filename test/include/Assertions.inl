@@ -5,12 +5,29 @@
 
 namespace gerryfudd {
   namespace test {
+    /*
+      How assert_equal describes two values that differ. By default both values are streamed
+      whole. A type whose values can be too large to print usefully declares
+      describe_difference(std::ostream&, const T&, const T&) beside itself, where argument
+      dependent lookup finds it, or specializes diff_formatter.
+    */
+    template <class T>
+    struct diff_formatter {
+      static void describe(std::ostream& out, const T& actual, const T& expected) {
+        if constexpr (requires { describe_difference(out, actual, expected); }) {
+          describe_difference(out, actual, expected);
+        } else {
+          out << "\"" << actual << "\" should equal \"" << expected << "\"";
+        }
+      }
+    };
+
     template <class commonType>
     void assert_equal(const commonType& actual, const commonType& expected)  {
       if (actual != expected) {
         std::stringstream capture_message;
         try {
-          capture_message << "\"" << actual << "\" should equal \"" << expected << "\"";
+          diff_formatter<commonType>::describe(capture_message, actual, expected);
         } catch(...) {
           capture_message << "Values are not equal. Exception encountered while streaming values to this error message. Consider implementing friend ostream& operator<<(ostream&,const T&)";
         }
@@ -23,6 +40,9 @@ namespace gerryfudd {
     void assert_false(bool);
     void assert_true(bool, const char*);
     void assert_true(bool);
+    // Both check usage since the test started or last called reset_memory_usage(), see MemoryTracking.hpp.
+    void assert_max_allocations(unsigned long);
+    void assert_peak_bytes_below(unsigned long);
   }
 }
 #endif
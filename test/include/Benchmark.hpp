@@ -0,0 +1,93 @@
+#ifndef BENCHMARK_TYPE
+#define BENCHMARK_TYPE
+#include <chrono>
+#include <string>
+
+namespace gerryfudd::test {
+  /*
+    Makes the compiler treat value as read and rewritten at this point. Use it on results so
+    their computation is not dropped and on inputs so work on them is not hoisted out of the loop.
+  */
+  template <class T>
+  inline void do_not_optimize(T& value) {
+    asm volatile("" : "+m"(value) : : "memory");
+  }
+
+  /*
+    Handed to a BENCHMARK body, which repeats the code under test while keep_running() is true:
+      while (state.keep_running()) { ... }
+    Only the loop is timed, so setup before it is free. Subclasses can take their own readings
+    just outside the timed loop by overriding on_start and on_stop.
+  */
+  class BenchmarkState {
+      unsigned long max_iterations;
+      unsigned long completed;
+      bool started;
+      bool finished;
+      std::chrono::steady_clock::time_point start;
+      std::chrono::steady_clock::time_point end;
+    protected:
+      virtual void on_start() {}
+      virtual void on_stop() {}
+    public:
+      BenchmarkState(unsigned long);
+      virtual ~BenchmarkState() = default;
+      bool keep_running();
+      // Zero for a body that never looped on keep_running()
+      unsigned long iterations() const;
+      double elapsed_ns() const;
+  };
+
+  /*
+    After a run, the iteration count to try next to reach min_time_ns, or 0 when the run was
+    long enough, hit the iteration limit, or never looped. It aims a little past the minimum so
+    that the next run is usually the last one.
+  */
+  unsigned long next_iteration_count(const BenchmarkState&, double min_time_ns);
+
+  /*
+    Runs a body with 1, then more and more iterations until one run takes at least min_time_ns,
+    and returns the state of that run. run(iterations) makes a state for that many iterations,
+    passes it to the body and returns it.
+  */
+  template <class Run>
+  auto calibrate(Run run, double min_time_ns) {
+    unsigned long iterations = 1;
+    while (true) {
+      auto state = run(iterations);
+      unsigned long next = next_iteration_count(state, min_time_ns);
+      if (next == 0) {
+        return state;
+      }
+      iterations = next;
+    }
+  }
+
+  // Nanoseconds per iteration across the timed samples of one benchmark
+  struct BenchmarkStats {
+    unsigned long iterations_per_sample;
+    unsigned int samples;
+    double min_ns;
+    double median_ns;
+    double p99_ns;
+  };
+
+  class Benchmark {
+      std::string filename;
+      int line;
+      std::string name;
+      void (*exec)(BenchmarkState&);
+    public:
+      Benchmark(const char*, int, const char*, void (*exec)(BenchmarkState&));
+      /*
+        Calibrates the iteration count until one sample takes at least sample_time_ns, runs
+        one more sample as a warmup, then times the given number of samples. A body that never
+        loops on keep_running() gets no samples.
+      */
+      BenchmarkStats run(double, unsigned int);
+      std::string get_filename(void);
+      std::string get_name(void);
+      int get_line(void);
+  };
+}
+#endif
@@ -6,6 +6,7 @@ namespace gerryfudd {
     namespace test {
         struct cheater_registrar {
             cheater_registrar(Test);
+            cheater_registrar(Benchmark);
         };
     }
 }
@@ -16,4 +17,17 @@ Test name ## _test(__FILE__, __LINE__, #name, &name); \
 cheater_registrar name ## _registered (name ## _test); \
 void name()
 
+/*
+  Registers a benchmark that runs with --bench instead of the tests. The body gets a
+  BenchmarkState with the given name and loops on it:
+    BENCHMARK(multiply_large, state) {
+      while (state.keep_running()) { ... }
+    }
+*/
+#define BENCHMARK(name, state) \
+void name(BenchmarkState&); \
+Benchmark name ## _benchmark(__FILE__, __LINE__, #name, &name); \
+cheater_registrar name ## _registered (name ## _benchmark); \
+void name(BenchmarkState& state)
+
 #endif
\ No newline at end of file
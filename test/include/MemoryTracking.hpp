@@ -0,0 +1,36 @@
+#ifndef MEMORY_TRACKING_DEFS
+#define MEMORY_TRACKING_DEFS
+
+namespace gerryfudd::test {
+  /*
+    Heap use on the calling thread, counted by the global operator new/delete replacements in
+    MemoryTracking.cpp. Linking that file into a binary is what turns the counting on; the test
+    and bench binaries both do. Peak bytes is the most that was live at once beyond what was live when
+    counting started. Memory allocated by threads a test starts itself is not counted.
+  */
+  struct memory_usage {
+    unsigned long allocations;
+    unsigned long bytes;
+    unsigned long peak_bytes;
+  };
+
+  // The runner calls these around each test.
+  void begin_test_memory_usage();
+  memory_usage test_memory_usage();
+
+  /*
+    What assert_max_allocations and assert_peak_bytes_below check: usage since the test started,
+    or since the test last called reset_memory_usage() to leave its setup out.
+  */
+  void reset_memory_usage();
+  memory_usage current_memory_usage();
+
+  // Allocations and bytes requested on every thread since the process started
+  struct allocation_counts {
+    unsigned long allocations;
+    unsigned long bytes;
+  };
+
+  allocation_counts process_allocations();
+}
+#endif
@@ -1,15 +1,21 @@
 #ifndef TEST_TYPE
 #define TEST_TYPE
 #define STACK_TRACE_CAPACITY 20
+#include <cstdint>
 #include <iostream>
 #include <exception>
 #include <vector>
 
 namespace gerryfudd {
     namespace test {
+        /*
+            Records where it was thrown as raw return addresses only. The addresses are turned
+            into function names when the failure is printed, which most caught failures never are.
+        */
         class AssertionFailure: public std::exception {
                 std::string message;
-                std::vector<std::string> trace;
+                uintptr_t trace[STACK_TRACE_CAPACITY];
+                unsigned short trace_depth;
             public:
                 AssertionFailure(std::string);
                 AssertionFailure(const char*);
@@ -27,6 +33,7 @@ namespace gerryfudd {
             Test(const char*, int, const char *, void (*exec)());
             bool run(unsigned short,std::ostream&,std::ostream&);
             std::string get_filename(void);
+            std::string get_name(void);
             int get_line(void);
         };
 
@@ -0,0 +1,35 @@
+#ifndef TIMINGS_DEFS
+#define TIMINGS_DEFS
+#include <MemoryTracking.hpp>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace gerryfudd::test {
+  struct TestTiming {
+    std::string name;
+    double elapsed_ms;
+    memory_usage memory;
+  };
+
+  /*
+    Baseline files hold one test per line so that they diff cleanly between commits:
+      {"tests": [
+        {"name": "multiplication", "ms": 12.345, "allocations": 40, "bytes": 3200, "peak_bytes": 1600},
+        ...
+      ]}
+  */
+  void write_timings(const std::vector<TestTiming>&, std::ostream&);
+  // Reads a file written by write_timings, keyed by test name. Lines that do not hold a test are skipped.
+  std::map<std::string, double> read_timings(std::istream&);
+
+  /*
+    Tests that took more than max_ratio times their baseline. Tests that finished in under
+    REGRESSION_FLOOR_MS are left out, since scheduling noise swamps anything that short, and
+    so are tests missing from the baseline.
+  */
+  const double REGRESSION_FLOOR_MS = 1.0;
+  std::vector<TestTiming> find_regressions(const std::vector<TestTiming>&, const std::map<std::string, double>&, double);
+}
+#endif
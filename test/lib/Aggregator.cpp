@@ -1,19 +1,106 @@
 #include <Aggregator.hpp>
+#include <Timings.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <exception>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <poll.h>
+#include <profiling/sampling_profiler.hpp>
 #include <sstream>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
 
 namespace gerryfudd::test {
   AggregationException::AggregationException(const char* message): message{message} {}
+  AggregationException::AggregationException(std::string message): message{message} {}
   const char* AggregationException::what() const _GLIBCXX_TXN_SAFE_DYN _GLIBCXX_NOTHROW {
     return message.c_str();
   }
 
+  const unsigned int DEFAULT_SLOWEST = 5;
+  const double DEFAULT_MAX_REGRESSION = 2.0;
+
+  RunOptions::RunOptions(): jobs{1}, fork_workers{false}, shard_index{0}, shard_count{1},
+    slowest{DEFAULT_SLOWEST}, max_regression{DEFAULT_MAX_REGRESSION}, benchmarks{false} {}
+
+  const char *option_value(const char *arg, const char *option) {
+    size_t length = std::strlen(option);
+    if (std::strncmp(arg, option, length) == 0) {
+      return arg + length;
+    }
+    return nullptr;
+  }
+
+  RunOptions RunOptions::parse(int argc, char **argv) {
+    RunOptions options;
+    const char *value;
+    for (int i = 1; i < argc; i++) {
+      if ((value = option_value(argv[i], "--jobs=")) != nullptr) {
+        options.jobs = std::strtoul(value, nullptr, 10);
+        if (options.jobs == 0) {
+          options.jobs = std::thread::hardware_concurrency();
+        }
+      } else if (std::strcmp(argv[i], "--fork") == 0) {
+        options.fork_workers = true;
+      } else if ((value = option_value(argv[i], "--shard=")) != nullptr) {
+        unsigned int index, count;
+        if (std::sscanf(value, "%u/%u", &index, &count) != 2 || index < 1 || index > count) {
+          throw AggregationException(std::string("Expected --shard=i/n with 1 <= i <= n, got ") + argv[i]);
+        }
+        options.shard_index = index - 1;
+        options.shard_count = count;
+      } else if ((value = option_value(argv[i], "--slowest=")) != nullptr) {
+        options.slowest = std::strtoul(value, nullptr, 10);
+      } else if ((value = option_value(argv[i], "--timings=")) != nullptr) {
+        options.timings_path = value;
+      } else if ((value = option_value(argv[i], "--baseline=")) != nullptr) {
+        options.baseline_path = value;
+      } else if ((value = option_value(argv[i], "--max-regression=")) != nullptr) {
+        options.max_regression = std::strtod(value, nullptr);
+        if (options.max_regression <= 0) {
+          throw AggregationException(std::string("Expected a positive ratio, got ") + argv[i]);
+        }
+      } else if (std::strcmp(argv[i], "--bench") == 0) {
+        options.benchmarks = true;
+      } else if ((value = option_value(argv[i], "--bench=")) != nullptr) {
+        options.benchmarks = true;
+        options.benchmark_filter = value;
+      } else if ((value = option_value(argv[i], "--profile=")) != nullptr) {
+        options.profile_path = value;
+      } else {
+        throw AggregationException(std::string("Unknown option ") + argv[i]
+          + "\nUsage: " + argv[0] + " [--jobs=<n>] [--fork] [--shard=<i>/<n>] [--slowest=<n>]"
+          + " [--timings=<json file>] [--baseline=<json file>] [--max-regression=<ratio>] [--bench[=<substring>]]"
+          + " [--profile=<folded stacks file>]");
+      }
+    }
+    if (options.fork_workers && !options.profile_path.empty()) {
+      throw AggregationException("--profile only samples this process, so it cannot be combined with --fork.");
+    }
+    if (options.jobs == 0) {
+      options.jobs = 1;
+    }
+    return options;
+  }
+
   std::vector<Test> Aggregator::tests;
   void Aggregator::add(Test t) {
     Aggregator::tests.push_back(t);
   }
 
+  std::vector<Benchmark> Aggregator::benchmarks;
+  void Aggregator::add(Benchmark b) {
+    Aggregator::benchmarks.push_back(b);
+  }
+
   bool update_name(char * name, const char * source) {
     bool changed = false;
     int i = 0;
@@ -27,32 +114,399 @@ namespace gerryfudd::test {
     return changed;
   }
 
-  int Aggregator::run_all() {
-    int failureCount = 0;
-    std::stringstream failure, info_buff, failure_buff;
+  /*
+    Prints results in registration order, grouped by file, as soon as every result before them
+    is complete. Tests may finish in any order when they run in parallel.
+  */
+  class ResultPrinter {
+      std::vector<Test>& tests;
+      const std::vector<int>& selected;
+      std::vector<TestResult>& results;
+      unsigned long next;
+      std::string current_file;
+    public:
+      int failure_count;
+      std::stringstream failure;
+
+      ResultPrinter(std::vector<Test>& tests, const std::vector<int>& selected, std::vector<TestResult>& results):
+        tests{tests}, selected{selected}, results{results}, next{0}, failure_count{0} {}
+
+      void print_completed() {
+        while (next < selected.size() && results[next].complete) {
+          Test& current_test = tests[selected[next]];
+          if (current_file != current_test.get_filename()) {
+            current_file = current_test.get_filename();
+            std::cout << std::endl << "Test file: " << current_file << std::endl << std::endl;
+          }
+          if (results[next].failed) {
+            failure_count++;
+            failure << std::endl << results[next].info << std::endl << results[next].failure;
+          }
+          std::cout << results[next].info << std::endl;
+          next++;
+        }
+      }
+  };
+
+  TestResult run_one(Test& test, int ordinal) {
+    std::stringstream info_buff, failure_buff;
+    begin_test_memory_usage();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool failed = test.run(ordinal, info_buff, failure_buff);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    memory_usage memory = test_memory_usage();
+    return {true, failed, elapsed.count(), memory, info_buff.str(), failure_buff.str()};
+  }
+
+  // ********** BEGIN threads **********
+  void run_threads(std::vector<Test>& tests, const std::vector<int>& selected, std::vector<TestResult>& results, unsigned int jobs, ResultPrinter& printer) {
+    std::atomic<unsigned long> next_test{0};
+    unsigned long completed = 0;
+    std::mutex results_lock;
+    std::condition_variable result_ready;
+
+    auto worker = [&]() {
+      unsigned long position;
+      while ((position = next_test.fetch_add(1)) < selected.size()) {
+        TestResult result = run_one(tests[selected[position]], selected[position] + 1);
+        std::lock_guard<std::mutex> guard(results_lock);
+        results[position] = result;
+        completed++;
+        result_ready.notify_one();
+      }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < jobs; i++) {
+      workers.emplace_back(worker);
+    }
+    {
+      std::unique_lock<std::mutex> guard(results_lock);
+      while (completed < selected.size()) {
+        printer.print_completed();
+        result_ready.wait(guard);
+      }
+    }
+    for (std::vector<std::thread>::iterator t = workers.begin(); t != workers.end(); t++) {
+      t->join();
+    }
+    printer.print_completed();
+  }
+  // ********** END threads **********
+
+  // ********** BEGIN forked workers **********
+  /*
+    A worker process runs its list of positions in the selection and reports each
+    result through a pipe as
+      4 bytes position, 1 byte failed, 4 bytes info length, 4 bytes failure length,
+      8 bytes elapsed milliseconds, 3 x 8 bytes memory usage, info, failure
+  */
+  struct worker_process {
+    pid_t pid;
+    int fd;
+    std::vector<unsigned long> positions;
+    unsigned long reported;
+    std::string buffer;
+  };
+
+  const size_t FRAME_HEADER_BYTES = 45;
+
+  void write_all(int fd, const char *data, size_t length) {
+    while (length > 0) {
+      ssize_t written = write(fd, data, length);
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        _exit(2);
+      }
+      data += written;
+      length -= written;
+    }
+  }
+
+  void report(int fd, unsigned int position, const TestResult& result) {
+    std::string frame(FRAME_HEADER_BYTES, '\0');
+    unsigned int info_length = result.info.size(), failure_length = result.failure.size();
+    std::memcpy(&frame[0], &position, 4);
+    frame[4] = result.failed ? 1 : 0;
+    std::memcpy(&frame[5], &info_length, 4);
+    std::memcpy(&frame[9], &failure_length, 4);
+    std::memcpy(&frame[13], &result.elapsed_ms, 8);
+    std::memcpy(&frame[21], &result.memory, 24);
+    frame += result.info;
+    frame += result.failure;
+    write_all(fd, frame.data(), frame.size());
+  }
+
+  worker_process spawn_worker(std::vector<Test>& tests, const std::vector<int>& selected, std::vector<unsigned long> positions) {
+    int pipe_fds[2];
+    if (pipe(pipe_fds) != 0) {
+      throw AggregationException("Unable to create a pipe for a test worker.");
+    }
+    // Anything still buffered would otherwise be printed again by the child.
+    std::cout.flush();
+    std::cerr.flush();
+    pid_t pid = fork();
+    if (pid < 0) {
+      throw AggregationException("Unable to fork a test worker.");
+    }
+    if (pid == 0) {
+      close(pipe_fds[0]);
+      for (std::vector<unsigned long>::iterator position = positions.begin(); position != positions.end(); position++) {
+        report(pipe_fds[1], *position, run_one(tests[selected[*position]], selected[*position] + 1));
+      }
+      close(pipe_fds[1]);
+      // Skip static destructors and atexit handlers that belong to the parent.
+      _exit(0);
+    }
+    close(pipe_fds[1]);
+    return {pid, pipe_fds[0], positions, 0, ""};
+  }
+
+  void read_frames(worker_process& worker, std::vector<TestResult>& results) {
+    while (worker.buffer.size() >= FRAME_HEADER_BYTES) {
+      unsigned int position, info_length, failure_length;
+      double elapsed_ms;
+      memory_usage memory;
+      std::memcpy(&position, &worker.buffer[0], 4);
+      std::memcpy(&info_length, &worker.buffer[5], 4);
+      std::memcpy(&failure_length, &worker.buffer[9], 4);
+      std::memcpy(&elapsed_ms, &worker.buffer[13], 8);
+      std::memcpy(&memory, &worker.buffer[21], 24);
+      if (worker.buffer.size() < FRAME_HEADER_BYTES + info_length + failure_length) {
+        return;
+      }
+      results[position] = {
+        true,
+        worker.buffer[4] != 0,
+        elapsed_ms,
+        memory,
+        worker.buffer.substr(FRAME_HEADER_BYTES, info_length),
+        worker.buffer.substr(FRAME_HEADER_BYTES + info_length, failure_length)
+      };
+      worker.buffer.erase(0, FRAME_HEADER_BYTES + info_length + failure_length);
+      worker.reported++;
+    }
+  }
+
+  std::string describe_exit(int status) {
+    std::stringstream description;
+    if (WIFSIGNALED(status)) {
+      description << "worker terminated by signal " << WTERMSIG(status) << " (" << strsignal(WTERMSIG(status)) << ")";
+    } else {
+      description << "worker exited with status " << WEXITSTATUS(status);
+    }
+    return description.str();
+  }
+
+  void run_forked(std::vector<Test>& tests, const std::vector<int>& selected, std::vector<TestResult>& results, unsigned int jobs, ResultPrinter& printer) {
+    std::vector<worker_process> workers;
+    for (unsigned int w = 0; w < jobs && w < selected.size(); w++) {
+      std::vector<unsigned long> positions;
+      for (unsigned long position = w; position < selected.size(); position += jobs) {
+        positions.push_back(position);
+      }
+      workers.push_back(spawn_worker(tests, selected, positions));
+    }
+
+    while (!workers.empty()) {
+      std::vector<pollfd> poll_fds;
+      for (std::vector<worker_process>::iterator worker = workers.begin(); worker != workers.end(); worker++) {
+        poll_fds.push_back({worker->fd, POLLIN, 0});
+      }
+      if (poll(poll_fds.data(), poll_fds.size(), -1) < 0 && errno != EINTR) {
+        throw AggregationException("Unable to wait for test workers.");
+      }
+
+      std::vector<worker_process> still_running;
+      for (unsigned long w = 0; w < workers.size(); w++) {
+        worker_process& worker = workers[w];
+        if (poll_fds[w].revents == 0) {
+          still_running.push_back(worker);
+          continue;
+        }
+        char chunk[4096];
+        ssize_t length = read(worker.fd, chunk, sizeof(chunk));
+        if (length > 0 || (length < 0 && errno == EINTR)) {
+          worker.buffer.append(chunk, length > 0 ? length : 0);
+          read_frames(worker, results);
+          still_running.push_back(worker);
+          continue;
+        }
+
+        // End of output: the worker either finished its list or died part way through it.
+        close(worker.fd);
+        int status;
+        waitpid(worker.pid, &status, 0);
+        if (worker.reported < worker.positions.size()) {
+          unsigned long crashed = worker.positions[worker.reported];
+          Test& crashed_test = tests[selected[crashed]];
+          std::stringstream info;
+          info << selected[crashed] + 1 << ". " << crashed_test.get_name()
+            << " (" << crashed_test.get_filename() << ":" << crashed_test.get_line() << ") CRASHED.";
+          results[crashed] = {true, true, 0, {0, 0, 0}, info.str(), describe_exit(status) + "\n"};
+          std::vector<unsigned long> remaining(worker.positions.begin() + worker.reported + 1, worker.positions.end());
+          if (!remaining.empty()) {
+            still_running.push_back(spawn_worker(tests, selected, remaining));
+          }
+        }
+      }
+      workers = still_running;
+      printer.print_completed();
+    }
+  }
+  // ********** END forked workers **********
+
+  // ********** BEGIN timings **********
+  void print_slowest(std::vector<TestTiming> timings, unsigned int count) {
+    if (count == 0 || timings.empty()) {
+      return;
+    }
+    if (count > timings.size()) {
+      count = timings.size();
+    }
+    std::partial_sort(timings.begin(), timings.begin() + count, timings.end(), [](const TestTiming& a, const TestTiming& b) {
+      return a.elapsed_ms > b.elapsed_ms;
+    });
+    std::cout << std::endl << "Slowest tests" << std::endl;
+    for (unsigned int i = 0; i < count; i++) {
+      std::cout << std::fixed << std::setprecision(3) << std::setw(12) << timings[i].elapsed_ms << " ms  " << timings[i].name << std::endl;
+    }
+    std::cout.unsetf(std::ios_base::floatfield);
+  }
+
+  std::map<std::string, double> load_baseline(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+      throw AggregationException("Unable to read the timings baseline " + path);
+    }
+    return read_timings(in);
+  }
+
+  unsigned long check_baseline(const std::vector<TestTiming>& timings, std::map<std::string, double>& baseline, const std::string& path, double max_ratio) {
+    std::vector<TestTiming> regressions = find_regressions(timings, baseline, max_ratio);
+    if (!regressions.empty()) {
+      std::cerr << std::endl << "Tests slower than " << max_ratio << "x their time in " << path << std::endl;
+      for (std::vector<TestTiming>::iterator regression = regressions.begin(); regression != regressions.end(); regression++) {
+        std::cerr << std::fixed << std::setprecision(3) << "  " << regression->name << ": "
+          << baseline[regression->name] << " ms -> " << regression->elapsed_ms << " ms" << std::endl;
+      }
+      std::cerr.unsetf(std::ios_base::floatfield);
+    }
+    return regressions.size();
+  }
+  // ********** END timings **********
+
+  // ********** BEGIN benchmarks **********
+  const double BENCHMARK_SAMPLE_TIME_NS = 2e6;
+  const unsigned int BENCHMARK_SAMPLES = 100;
+
+  int Aggregator::run_benchmarks(const std::string& filter) {
     std::string current_file;
-    int ordinal = 1;
+    for (std::vector<Benchmark>::iterator benchmark = benchmarks.begin(); benchmark != benchmarks.end(); benchmark++) {
+      if (benchmark->get_name().find(filter) == std::string::npos) {
+        continue;
+      }
+      if (current_file != benchmark->get_filename()) {
+        current_file = benchmark->get_filename();
+        std::cout << std::endl << "Benchmark file: " << current_file << std::endl << std::endl;
+        std::cout << std::left << std::setw(40) << "name" << std::right << std::setw(14) << "min ns" << std::setw(14) << "median ns"
+          << std::setw(14) << "p99 ns" << "  samples x iterations" << std::endl;
+      }
+      BenchmarkStats stats = benchmark->run(BENCHMARK_SAMPLE_TIME_NS, BENCHMARK_SAMPLES);
+      if (stats.samples == 0) {
+        std::cout << std::left << std::setw(40) << benchmark->get_name() << "  never looped on keep_running()" << std::endl;
+        continue;
+      }
+      std::cout << std::left << std::setw(40) << benchmark->get_name() << std::right << std::fixed << std::setprecision(1)
+        << std::setw(14) << stats.min_ns << std::setw(14) << stats.median_ns << std::setw(14) << stats.p99_ns
+        << "  " << stats.samples << " x " << stats.iterations_per_sample << std::endl;
+    }
+    return 0;
+  }
+  // ********** END benchmarks **********
+
+  int Aggregator::run_all(int argc, char **argv) {
+    try {
+      return run_all(RunOptions::parse(argc, argv));
+    } catch (AggregationException& e) {
+      std::cerr << e.what() << std::endl;
+      return 1;
+    }
+  }
+
+  int Aggregator::run_all(const RunOptions& options) {
+    if (options.profile_path.empty()) {
+      return run_selected(options);
+    }
+    std::ofstream profile(options.profile_path);
+    if (!profile) {
+      throw AggregationException("Unable to write the profile to " + options.profile_path);
+    }
+    profiling::start_profiling();
+    int failures = run_selected(options);
+    profiling::stop_profiling();
+    profiling::profile_totals totals = profiling::profile_so_far();
+    profiling::write_folded(profile);
+    std::cout << "Wrote " << totals.samples << " samples (" << totals.dropped << " dropped) to " << options.profile_path << std::endl;
+    return failures;
+  }
+
+  int Aggregator::run_selected(const RunOptions& options) {
+    if (options.benchmarks) {
+      return run_benchmarks(options.benchmark_filter);
+    }
+    // Read the baseline first so that a bad path fails before the tests run.
+    std::map<std::string, double> baseline;
+    if (!options.baseline_path.empty()) {
+      baseline = load_baseline(options.baseline_path);
+    }
+    std::vector<int> selected;
+    for (int i = options.shard_index; i < tests.size(); i += options.shard_count) {
+      selected.push_back(i);
+    }
+    std::vector<TestResult> results(selected.size(), {false, false, 0, {0, 0, 0}, "", ""});
+    ResultPrinter printer(tests, selected, results);
 
-    for (std::vector<Test>::iterator current_test = tests.begin(); current_test != tests.end(); current_test++) {
-      info_buff.str(std::string());
-      failure_buff.str(std::string());
-      if (current_file != current_test->get_filename()) {
-        current_file = current_test->get_filename();
-        std::cout << std::endl << "Test file: " << current_file << std::endl << std::endl;
+    if (options.shard_count > 1) {
+      std::cout << "Shard " << options.shard_index + 1 << " of " << options.shard_count
+        << ": " << selected.size() << " of " << tests.size() << " tests" << std::endl;
+    }
+    if (options.fork_workers) {
+      run_forked(tests, selected, results, options.jobs, printer);
+    } else if (options.jobs > 1) {
+      run_threads(tests, selected, results, options.jobs, printer);
+    } else {
+      for (unsigned long position = 0; position < selected.size(); position++) {
+        results[position] = run_one(tests[selected[position]], selected[position] + 1);
+        printer.print_completed();
       }
-      if (current_test->run(ordinal++, info_buff, failure_buff)) {
-        failureCount++;
-        failure << std::endl << info_buff.str() << std::endl << failure_buff.str();
+    }
+
+    std::vector<TestTiming> timings;
+    for (unsigned long position = 0; position < selected.size(); position++) {
+      timings.push_back({tests[selected[position]].get_name(), results[position].elapsed_ms, results[position].memory});
+    }
+    print_slowest(timings, options.slowest);
+    if (!options.timings_path.empty()) {
+      std::ofstream out(options.timings_path);
+      if (!out) {
+        throw AggregationException("Unable to write test timings to " + options.timings_path);
       }
-      std::cout << info_buff.str() << std::endl;
+      write_timings(timings, out);
+    }
+    unsigned long regression_count = 0;
+    if (!options.baseline_path.empty()) {
+      regression_count = check_baseline(timings, baseline, options.baseline_path, options.max_regression);
     }
 
-    if (failureCount > 0) {
+    if (printer.failure_count > 0) {
       std::cerr << "Test failures" << std::endl;
-      std::cerr << failure.str() << std::endl;
-    } else {
+      std::cerr << printer.failure.str() << std::endl;
+    } else if (regression_count == 0) {
       std::cout << std::endl << std::endl << "ALL TESTS PASSED" << std::endl << std::endl;
     }
-    return failureCount;
+    return printer.failure_count + regression_count;
   }
-}
\ No newline at end of file
+}
@@ -1,4 +1,5 @@
 #include <Assertions.inl>
+#include <MemoryTracking.hpp>
 
 namespace gerryfudd::test {
   void assert_equal_strings(const char *actual, const char *expected) {
@@ -20,4 +21,21 @@ namespace gerryfudd::test {
   void assert_true(bool value) {
     assert_true(value, "Value was expected to be true.");
   }
+  void assert_max_allocations(unsigned long max_allocations) {
+    memory_usage usage = current_memory_usage();
+    if (usage.allocations > max_allocations) {
+      std::stringstream capture_message;
+      capture_message << "Expected at most " << max_allocations << " allocations, got " << usage.allocations
+        << " (" << usage.bytes << " bytes)";
+      throw AssertionFailure(capture_message.str());
+    }
+  }
+  void assert_peak_bytes_below(unsigned long limit) {
+    memory_usage usage = current_memory_usage();
+    if (usage.peak_bytes >= limit) {
+      std::stringstream capture_message;
+      capture_message << "Expected fewer than " << limit << " bytes live at once, peaked at " << usage.peak_bytes;
+      throw AssertionFailure(capture_message.str());
+    }
+  }
 }
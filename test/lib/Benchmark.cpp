@@ -0,0 +1,89 @@
+#include <Benchmark.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace gerryfudd::test {
+  // Stop calibrating once a single run would exceed this many iterations.
+  const unsigned long MAX_ITERATIONS_PER_SAMPLE = 1000000000;
+
+  BenchmarkState::BenchmarkState(unsigned long max_iterations):
+    max_iterations{max_iterations}, completed{0}, started{false}, finished{false} {}
+
+  bool BenchmarkState::keep_running() {
+    if (!started) {
+      started = true;
+      on_start();
+      start = std::chrono::steady_clock::now();
+      return completed < max_iterations;
+    }
+    completed++;
+    if (completed < max_iterations) {
+      return true;
+    }
+    end = std::chrono::steady_clock::now();
+    finished = true;
+    on_stop();
+    return false;
+  }
+
+  unsigned long BenchmarkState::iterations() const {
+    return completed;
+  }
+
+  double BenchmarkState::elapsed_ns() const {
+    return finished ? std::chrono::duration<double, std::nano>(end - start).count() : 0;
+  }
+
+  unsigned long next_iteration_count(const BenchmarkState& state, double min_time_ns) {
+    double elapsed = state.elapsed_ns();
+    unsigned long iterations = state.iterations();
+    if (iterations == 0 || elapsed >= min_time_ns || iterations >= MAX_ITERATIONS_PER_SAMPLE) {
+      return 0;
+    }
+    double multiplier = elapsed > 0 ? min_time_ns * 1.2 / elapsed : 10;
+    return (unsigned long) (iterations * std::clamp(multiplier, 2.0, 10.0));
+  }
+
+  Benchmark::Benchmark(const char *filename, int line, const char *name, void (*exec)(BenchmarkState&)):
+    filename{filename}, line{line}, name{name}, exec{exec} {}
+
+  double sample(void (*exec)(BenchmarkState&), unsigned long iterations) {
+    BenchmarkState state(iterations);
+    exec(state);
+    return state.iterations() > 0 ? state.elapsed_ns() / state.iterations() : 0;
+  }
+
+  BenchmarkStats Benchmark::run(double sample_time_ns, unsigned int samples) {
+    BenchmarkState calibrated = calibrate([this](unsigned long iterations) {
+      BenchmarkState state(iterations);
+      exec(state);
+      return state;
+    }, sample_time_ns);
+    unsigned long iterations = calibrated.iterations();
+    if (iterations == 0) {
+      return {0, 0, 0, 0, 0};
+    }
+    // Warm caches and branch predictors at the final iteration count before anything counts.
+    sample(exec, iterations);
+
+    std::vector<double> ns_per_iteration;
+    for (unsigned int i = 0; i < samples; i++) {
+      ns_per_iteration.push_back(sample(exec, iterations));
+    }
+    std::sort(ns_per_iteration.begin(), ns_per_iteration.end());
+    unsigned long p99 = (ns_per_iteration.size() * 99 + 99) / 100 - 1;
+    return {iterations, samples, ns_per_iteration.front(), ns_per_iteration[ns_per_iteration.size() / 2], ns_per_iteration[p99]};
+  }
+
+  std::string Benchmark::get_filename() {
+    return filename;
+  }
+
+  std::string Benchmark::get_name() {
+    return name;
+  }
+
+  int Benchmark::get_line() {
+    return line;
+  }
+}
@@ -4,4 +4,7 @@ namespace gerryfudd::test {
   cheater_registrar::cheater_registrar(Test t) {
     Aggregator::add(t);
   };
+  cheater_registrar::cheater_registrar(Benchmark b) {
+    Aggregator::add(b);
+  };
 }
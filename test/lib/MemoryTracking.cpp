@@ -0,0 +1,115 @@
+#include <MemoryTracking.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace gerryfudd::test {
+  struct usage_counter {
+    unsigned long allocations;
+    unsigned long bytes;
+    long live_at_start;
+    long peak;
+  };
+
+  std::atomic<unsigned long> process_allocation_count{0};
+  std::atomic<unsigned long> process_allocated_bytes{0};
+
+  // Only trivially constructed thread_locals, so the hooks never allocate or run initializers themselves.
+  thread_local long live_bytes = 0;
+  thread_local usage_counter whole_test = {0, 0, 0, 0};
+  thread_local usage_counter checkpoint = {0, 0, 0, 0};
+
+  void start(usage_counter& counter) {
+    counter = {0, 0, live_bytes, live_bytes};
+  }
+
+  memory_usage read(const usage_counter& counter) {
+    return {counter.allocations, counter.bytes, (unsigned long) (counter.peak - counter.live_at_start)};
+  }
+
+  void begin_test_memory_usage() {
+    start(whole_test);
+    start(checkpoint);
+  }
+
+  memory_usage test_memory_usage() {
+    return read(whole_test);
+  }
+
+  void reset_memory_usage() {
+    start(checkpoint);
+  }
+
+  memory_usage current_memory_usage() {
+    return read(checkpoint);
+  }
+
+  allocation_counts process_allocations() {
+    return {
+      process_allocation_count.load(std::memory_order_relaxed),
+      process_allocated_bytes.load(std::memory_order_relaxed)
+    };
+  }
+
+  void count(usage_counter& counter, std::size_t size) {
+    counter.allocations++;
+    counter.bytes += size;
+    if (live_bytes > counter.peak) {
+      counter.peak = live_bytes;
+    }
+  }
+
+  /*
+    Every block carries its size in a header so that a free can take it off the live total.
+    The header is max_align_t sized to keep the memory handed out suitably aligned.
+  */
+  const std::size_t HEADER_BYTES = alignof(std::max_align_t);
+
+  void *tracked_allocation(std::size_t size) {
+    char *block = (char *) std::malloc(size + HEADER_BYTES);
+    if (block == nullptr) {
+      throw std::bad_alloc();
+    }
+    *(std::size_t *) block = size;
+    process_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    process_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    live_bytes += size;
+    count(whole_test, size);
+    count(checkpoint, size);
+    return block + HEADER_BYTES;
+  }
+
+  void tracked_free(void *p) {
+    if (p == nullptr) {
+      return;
+    }
+    char *block = (char *) p - HEADER_BYTES;
+    live_bytes -= *(std::size_t *) block;
+    std::free(block);
+  }
+}
+
+void *operator new(std::size_t size) {
+  return gerryfudd::test::tracked_allocation(size);
+}
+
+void *operator new[](std::size_t size) {
+  return gerryfudd::test::tracked_allocation(size);
+}
+
+void operator delete(void *p) noexcept {
+  gerryfudd::test::tracked_free(p);
+}
+
+void operator delete[](void *p) noexcept {
+  gerryfudd::test::tracked_free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+  gerryfudd::test::tracked_free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept {
+  gerryfudd::test::tracked_free(p);
+}
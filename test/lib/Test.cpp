@@ -1,52 +1,13 @@
 #include <Test.hpp>
-#define UNW_LOCAL_ONLY
-#include <libunwind.h>
-#include <execinfo.h>
-#include <cxxabi.h>
-#include <sstream>
+#include <exception_utils/stack_trace.hpp>
 
 namespace gerryfudd::test {
-  const char *as_char_pointer(std::string str_text) {
-    char *text = new char[str_text.length() + 1];
-    text[str_text.length()] = '\0';
-    for (int i = 0; i < str_text.length(); i++) {
-      text[i] = str_text[i];
-    }
-    return text;
+  // Both constructors skip their own frame so that the trace starts at the code that threw.
+  AssertionFailure::AssertionFailure(std::string message): message{message} {
+    trace_depth = exception_utils::capture_stack(trace, STACK_TRACE_CAPACITY, 1);
   }
-  AssertionFailure::AssertionFailure(std::string str_message): AssertionFailure::AssertionFailure(as_char_pointer(str_message)) {}
   AssertionFailure::AssertionFailure(const char* message): message{message} {
-    std::stringstream trace_captor;
-    unw_cursor_t cursor;
-    unw_context_t context;
-
-    // Initialize cursor to current frame for local unwinding.
-    unw_getcontext(&context);
-    unw_init_local(&cursor, &context);
-
-    // Unwind frames one by one, going up the frame stack.
-    while (unw_step(&cursor) > 0) {
-      unw_word_t offset, pc;
-      unw_get_reg(&cursor, UNW_REG_IP, &pc);
-      if (pc == 0) {
-        break;
-      }
-      trace_captor.str("");
-
-      char sym[256];
-      if (unw_get_proc_name(&cursor, sym, sizeof(sym), &offset) == 0) {
-        char* print_me = sym;
-        int status;
-        char* demangled = abi::__cxa_demangle(sym, nullptr, nullptr, &status);
-        if (status == 0) {
-          print_me = demangled;
-        }
-        trace_captor << print_me;
-      } else {
-        trace_captor << "-- error: unable to obtain symbol name for this frame";
-      }
-      trace.push_back(trace_captor.str());
-    }
+    trace_depth = exception_utils::capture_stack(trace, STACK_TRACE_CAPACITY, 1);
   }
   const char* AssertionFailure::what() const _GLIBCXX_TXN_SAFE_DYN _GLIBCXX_NOTHROW {
     return message.c_str();
@@ -54,8 +15,8 @@ namespace gerryfudd::test {
 
   std::ostream& operator<<(std::ostream& out, const AssertionFailure &e) {
     out << e.message << std::endl;
-    for (std::vector<std::string>::const_iterator trace_line = e.trace.begin(); trace_line != e.trace.end(); trace_line++) {
-      out << "    " << *trace_line << std::endl;
+    for (unsigned short i = 0; i < e.trace_depth; i++) {
+      out << "    " << exception_utils::symbol_for(e.trace[i]) << std::endl;
     }
     return out;
   }
@@ -81,6 +42,10 @@ namespace gerryfudd::test {
     return filename;
   }
 
+  std::string Test::get_name() {
+    return name;
+  }
+
   int Test::get_line() {
     return line;
   }
@@ -0,0 +1,47 @@
+#include <Timings.hpp>
+#include <cstdlib>
+#include <iomanip>
+
+namespace gerryfudd::test {
+  void write_timings(const std::vector<TestTiming>& timings, std::ostream& out) {
+    out << "{\"tests\": [" << std::endl;
+    for (unsigned long i = 0; i < timings.size(); i++) {
+      out << std::fixed << std::setprecision(3)
+        << "  {\"name\": \"" << timings[i].name << "\", \"ms\": " << timings[i].elapsed_ms
+        << ", \"allocations\": " << timings[i].memory.allocations << ", \"bytes\": " << timings[i].memory.bytes
+        << ", \"peak_bytes\": " << timings[i].memory.peak_bytes << "}"
+        << (i + 1 < timings.size() ? "," : "") << std::endl;
+    }
+    out << "]}" << std::endl;
+  }
+
+  std::map<std::string, double> read_timings(std::istream& in) {
+    const std::string name_key = "\"name\": \"", ms_key = "\"ms\": ";
+    std::map<std::string, double> timings;
+    std::string line;
+    while (std::getline(in, line)) {
+      size_t name_start = line.find(name_key), ms_start = line.find(ms_key);
+      if (name_start == std::string::npos || ms_start == std::string::npos) {
+        continue;
+      }
+      name_start += name_key.size();
+      size_t name_end = line.find('"', name_start);
+      if (name_end == std::string::npos) {
+        continue;
+      }
+      timings[line.substr(name_start, name_end - name_start)] = std::strtod(line.c_str() + ms_start + ms_key.size(), nullptr);
+    }
+    return timings;
+  }
+
+  std::vector<TestTiming> find_regressions(const std::vector<TestTiming>& timings, const std::map<std::string, double>& baseline, double max_ratio) {
+    std::vector<TestTiming> regressions;
+    for (std::vector<TestTiming>::const_iterator timing = timings.begin(); timing != timings.end(); timing++) {
+      std::map<std::string, double>::const_iterator stored = baseline.find(timing->name);
+      if (stored != baseline.end() && timing->elapsed_ms >= REGRESSION_FLOOR_MS && timing->elapsed_ms > stored->second * max_ratio) {
+        regressions.push_back(*timing);
+      }
+    }
+    return regressions;
+  }
+}
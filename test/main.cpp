@@ -2,6 +2,6 @@
 
 using namespace gerryfudd::test;
 
-int main() {
-    return Aggregator::run_all();
+int main(int argc, char **argv) {
+    return Aggregator::run_all(argc, argv);
 }
@@ -0,0 +1,32 @@
+#include <Framework.hpp>
+#include <Assertions.inl>
+
+using namespace gerryfudd::test;
+
+void never_loops(BenchmarkState&) {}
+
+void loops(BenchmarkState& state) {
+  unsigned long count = 0;
+  while (state.keep_running()) {
+    count++;
+    do_not_optimize(count);
+  }
+}
+
+TEST(benchmark_that_never_loops_gets_no_samples)
+{
+  BenchmarkState state(10);
+  assert_equal<unsigned long>(state.iterations(), 0);
+  assert_equal<double>(state.elapsed_ns(), 0);
+  assert_equal<unsigned long>(next_iteration_count(state, 1e6), 0);
+  BenchmarkStats stats = Benchmark(__FILE__, __LINE__, "never_loops", &never_loops).run(1e6, 5);
+  assert_equal<unsigned int>(stats.samples, 0);
+  assert_equal<unsigned long>(stats.iterations_per_sample, 0);
+}
+
+TEST(benchmark_calibrates_until_a_sample_is_long_enough)
+{
+  BenchmarkStats stats = Benchmark(__FILE__, __LINE__, "loops", &loops).run(1e5, 5);
+  assert_equal<unsigned int>(stats.samples, 5);
+  assert_true(stats.iterations_per_sample > 1, "A one iteration loop should need more than one iteration per sample.");
+}
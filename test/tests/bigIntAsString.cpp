@@ -1,6 +1,7 @@
 #include <Framework.hpp>
 #include <Assertions.inl>
 #include <math/BigInt.hpp>
+#include <vector>
 
 using namespace gerryfudd::math;
 using namespace gerryfudd::test;
@@ -89,3 +90,21 @@ TEST(to_hex_string_test_large_with_intermediate_zeros)
   string result = test_int.as_hex_string();
   assert_equal<string>(result, "0x200000001");
 }
+
+TEST(failed_assertion_describes_only_the_differing_words)
+{
+  std::vector<unsigned int> words(20000, 0x01234567);
+  BigInt expected(words.data(), words.size(), false);
+  words[10000] = 0xabcd;
+  BigInt actual(words.data(), words.size(), false);
+  std::string message;
+  try {
+    assert_equal<BigInt>(actual, expected);
+  } catch (AssertionFailure& failure) {
+    message = failure.what();
+  }
+  assert_true(message.find("differ from word 10000") != std::string::npos, "Expected the first differing word.");
+  assert_true(message.find("20000 words, positive, words 10002..9998: 0x01234567 0x01234567 [0x0000abcd]") != std::string::npos,
+    "Expected a hex window around the differing word.");
+  assert_true(message.size() < 400, "Expected the message to leave out the rest of the words.");
+}
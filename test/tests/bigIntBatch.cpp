@@ -0,0 +1,114 @@
+#include <Framework.hpp>
+#include <Assertions.inl>
+#include <exception_utils/enriched_exception.hpp>
+#include <math/BigIntBatch.hpp>
+
+using namespace gerryfudd::math;
+using namespace gerryfudd::test;
+
+TEST(batch_round_trips_values)
+{
+  unsigned int mag_a[] = {0x80700230, 0x2047}, mag_b[] = {0xffffffff, 0x7fffffff};
+  BigIntBatch batch(4, 2);
+  batch.set(0, BigInt(mag_a, 2, false));
+  batch.set(1, BigInt(mag_a, 2, true));
+  batch.set(2, BigInt(mag_b, 2, true));
+  assert_equal<BigInt>(batch.get(0), BigInt(mag_a, 2, false));
+  assert_equal<BigInt>(batch.get(1), BigInt(mag_a, 2, true));
+  assert_equal<BigInt>(batch.get(2), BigInt(mag_b, 2, true));
+  assert_equal<BigInt>(batch.get(3), BigInt());
+}
+
+TEST(batch_rejects_values_that_do_not_fit)
+{
+  unsigned int mag[] = {0, 0x80000000};
+  BigIntBatch batch(1, 2);
+  bool rejected = false;
+  try {
+    batch.set(0, BigInt(mag, 2, false));
+  } catch (gerryfudd::exception_utils::enriched_exception&) {
+    rejected = true;
+  }
+  assert_true(rejected, "A value using the sign bit of the top word should not fit.");
+}
+
+TEST(batch_rejects_values_longer_than_an_unsigned_short)
+{
+  // 65537 words, which an unsigned short length would have counted as 1
+  vector<unsigned int> mag(65537, 0);
+  mag[0] = 1;
+  mag[65536] = 1;
+  BigIntBatch batch(1, 2);
+  bool rejected = false;
+  try {
+    batch.set(0, BigInt(mag, false));
+  } catch (gerryfudd::exception_utils::enriched_exception&) {
+    rejected = true;
+  }
+  assert_true(rejected, "A value of 65537 words should not fit in 2.");
+}
+
+TEST(batch_add_carries_into_wider_result)
+{
+  unsigned int mag_a[] = {0x80700230, 0x70475d1e}, mag_b[] = {0xc00e00f2, 0x5fffffff},
+    mag_sum[] = {0x407e0322, 0xd0475d1e};
+  BigIntBatch a(2, 2), b(2, 2), result(2, 3);
+  a.set(0, BigInt(mag_a, 2, false));
+  b.set(0, BigInt(mag_b, 2, false));
+  a.set(1, BigInt(14, true));
+  b.set(1, BigInt(11));
+  batch_add(a, b, result);
+  assert_equal<BigInt>(result.get(0), BigInt(mag_sum, 2, false));
+  assert_equal<BigInt>(result.get(1), BigInt(3, true));
+}
+
+TEST(batch_sub_crosses_zero)
+{
+  BigIntBatch a(3, 1), b(3, 1), result(3, 2);
+  a.set(0, BigInt(22));
+  b.set(0, BigInt(38));
+  a.set(1, BigInt(38, true));
+  b.set(1, BigInt(22));
+  a.set(2, BigInt(5, true));
+  b.set(2, BigInt(5, true));
+  batch_sub(a, b, result);
+  assert_equal<BigInt>(result.get(0), BigInt(16, true));
+  assert_equal<BigInt>(result.get(1), BigInt(60, true));
+  assert_equal<BigInt>(result.get(2), BigInt());
+}
+
+TEST(batch_mult_matches_big_int_for_mixed_signs)
+{
+  unsigned int mag_a[] = {0x80700230, 0x20475d1e}, mag_b[] = {0xc00e00f2, 0x5fffffff};
+  BigInt values_a[] = {BigInt(mag_a, 2, false), BigInt(mag_a, 2, true), BigInt(mag_a, 2, true), BigInt(7)};
+  BigInt values_b[] = {BigInt(mag_b, 2, false), BigInt(mag_b, 2, false), BigInt(mag_b, 2, true), BigInt(mag_b, 2, true)};
+  BigIntBatch a(4, 2), b(4, 2), result(4, 4);
+  for (int i = 0; i < 4; i++) {
+    a.set(i, values_a[i]);
+    b.set(i, values_b[i]);
+  }
+  batch_mult(a, b, result);
+  for (int i = 0; i < 4; i++) {
+    assert_equal<BigInt>(result.get(i), values_a[i] * values_b[i]);
+  }
+}
+
+TEST(threaded_batch_matches_single_thread)
+{
+  unsigned long lanes = 3000;
+  BigIntBatch a(lanes, 3), b(lanes, 3), sum(lanes, 4), product(lanes, 6), expected_sum(lanes, 4), expected_product(lanes, 6);
+  for (unsigned long lane = 0; lane < lanes; lane++) {
+    unsigned int mag_a[] = {(unsigned int) (lane * 0x9e3779b9), (unsigned int) lane, 0x12345}, mag_b[] = {0xffffffff, (unsigned int) (lane << 7), 0x7ff};
+    a.set(lane, BigInt(mag_a, 3, lane % 3 == 0));
+    b.set(lane, BigInt(mag_b, 3, lane % 5 == 0));
+  }
+  batch_add(a, b, expected_sum, 1);
+  batch_add(a, b, sum, 4);
+  batch_mult(a, b, expected_product, 1);
+  batch_mult(a, b, product, 4);
+  for (unsigned long lane = 0; lane < lanes; lane++) {
+    assert_equal<BigInt>(sum.get(lane), expected_sum.get(lane));
+    assert_equal<BigInt>(product.get(lane), expected_product.get(lane));
+    assert_equal<BigInt>(product.get(lane), a.get(lane) * b.get(lane));
+  }
+}
@@ -0,0 +1,50 @@
+#include <Framework.hpp>
+#include <Assertions.inl>
+#include <math/BigIntExpr.hpp>
+
+using namespace gerryfudd::math;
+using namespace gerryfudd::test;
+
+TEST(lazy_sum_matches_eager_sum)
+{
+  unsigned int mag_a[] = {0x80700230, 0xa0475d1e, 0x43875002, 0x213},
+    mag_b[] = {0xc00e00f2, 0x5fffffff},
+    mag_c[] = {0xffffffff, 0xffffffff, 0xffffffff};
+  BigInt a(mag_a, 4, false), b(mag_b, 2, true), c(mag_c, 3, false), d(77, true);
+  BigInt lazy_result = lazy(a) + b - c + d, eager_result = a + b - c + d;
+  assert_equal<BigInt>(lazy_result, eager_result);
+}
+
+TEST(lazy_sum_carries_across_every_word)
+{
+  unsigned int mag_a[] = {0xffffffff, 0xffffffff, 0xffffffff}, mag_sum[] = {0xfffffffe, 0xffffffff, 0xffffffff, 0x2};
+  BigInt a(mag_a, 3, false);
+  BigInt result = lazy(a) + a + a;
+  assert_equal<BigInt>(result, a + a + a);
+  assert_equal<BigInt>(result, BigInt(mag_sum, 4, false) - BigInt(1));
+}
+
+TEST(lazy_sum_goes_negative)
+{
+  BigInt a(38), b(22), c(60);
+  BigInt result = lazy(b) - a - c;
+  assert_equal<BigInt>(result, BigInt(76, true));
+  BigInt negated = -lazy(a) + c;
+  assert_equal<BigInt>(negated, BigInt(22));
+}
+
+TEST(lazy_sum_to_zero)
+{
+  unsigned int mag[] = {0x80700230, 0xa0475d1e};
+  BigInt a(mag, 2, true), b(mag, 2, false);
+  BigInt result = lazy(a) + b;
+  assert_equal<BigInt>(result, BigInt());
+}
+
+TEST(lazy_shifted_terms)
+{
+  unsigned int mag_a[] = {0x1, 0x2}, mag_b[] = {0x3}, mag_sum[] = {0x3, 0x1, 0x2};
+  BigInt a(mag_a, 2, false), b(mag_b, 1, false);
+  BigInt result = lazy(a, 1) + b;
+  assert_equal<BigInt>(result, BigInt(mag_sum, 3, false));
+}
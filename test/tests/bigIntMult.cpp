@@ -271,3 +271,32 @@ TEST(multiply_karatsuba) {
   BigInt a(mag_a, 91, false), b(mag_b, 204, false), c(mag_c, 295, false);
   assert_equal<BigInt>(a * b, c);
 }
+
+// Found by ./do_fuzz.sh: splitting 81 words at 80 used to drop the single upper word.
+TEST(multiply_karatsuba_one_upper_word) {
+  std::vector<unsigned int> mag_a(81, 0), mag_b(160, 0), mag_c(240, 0);
+  mag_a.back() = 1;
+  mag_b.back() = 1;
+  mag_c.back() = 1;
+  BigInt a(mag_a, false), b(mag_b, true), c(mag_c, true);
+  assert_equal<BigInt>(a * b, c);
+  assert_equal<BigInt>(b * a, c);
+}
+
+BENCHMARK(multiply_schoolbook_benchmark, state) {
+  std::vector<unsigned int> mag_a(40, 0x9e3779b9), mag_b(40, 0x7f4a7c15);
+  BigInt a(mag_a, false), b(mag_b, false), product;
+  while (state.keep_running()) {
+    product = a * b;
+    do_not_optimize(product);
+  }
+}
+
+BENCHMARK(multiply_karatsuba_benchmark, state) {
+  std::vector<unsigned int> mag_a(200, 0x9e3779b9), mag_b(200, 0x7f4a7c15);
+  BigInt a(mag_a, false), b(mag_b, false), product;
+  while (state.keep_running()) {
+    product = a * b;
+    do_not_optimize(product);
+  }
+}
@@ -0,0 +1,89 @@
+#include <Framework.hpp>
+#include <Assertions.inl>
+#include <fstream>
+#include <sstream>
+#include <stdlib.h>
+#include <unistd.h>
+#include <exception_utils/enriched_exception.hpp>
+#include <math/BigIntExpr.hpp>
+#include <math/BigIntSerial.hpp>
+
+using namespace gerryfudd::math;
+using namespace gerryfudd::test;
+
+TEST(parse_decimal_string)
+{
+  unsigned int mag[] = {0x80700230, 0xa0475d1e, 0x43875002, 0x213};
+  BigInt value(mag, 4, true);
+  assert_equal<BigInt>(BigInt::from_decimal_string(value.as_decimal_string()), value);
+  assert_equal<BigInt>(BigInt::from_decimal_string("1000000000"), BigInt(1000000000));
+  assert_equal<BigInt>(BigInt::from_decimal_string("-0"), BigInt());
+}
+
+TEST(parse_hex_string)
+{
+  unsigned int mag[] = {0x80700230, 0xa0475d1e, 0x43875002, 0x213};
+  BigInt value(mag, 4, true);
+  assert_equal<BigInt>(BigInt::from_hex_string(value.as_hex_string()), value);
+  assert_equal<BigInt>(BigInt::from_hex_string("0xFFffFFff"), BigInt(0xffffffff));
+}
+
+TEST(binary_round_trip)
+{
+  unsigned int mag[] = {0x80700230, 0xa0475d1e, 0x43875002, 0x213, 0};
+  BigInt values[] = {BigInt(mag, 5, false), BigInt(mag, 4, true), BigInt(), BigInt(0), BigInt(7, true)};
+  std::stringstream buffer;
+  for (int i = 0; i < 5; i++) {
+    write_binary(buffer, values[i]);
+  }
+  // The leading zero word is dropped, so the first value takes a header and four words
+  assert_equal<std::size_t>(buffer.str().size(), 4 * (1 + 4) + 4 * (1 + 4) + 4 + 4 + 4 * (1 + 1));
+  assert_equal<BigInt>(read_binary(buffer), BigInt(mag, 4, false));
+  assert_equal<BigInt>(read_binary(buffer), BigInt(mag, 4, true));
+  assert_equal<BigInt>(read_binary(buffer), BigInt());
+  assert_equal<BigInt>(read_binary(buffer), BigInt());
+  assert_equal<BigInt>(read_binary(buffer), BigInt(7, true));
+}
+
+TEST(binary_read_of_a_corrupt_header_allocates_only_what_arrives)
+{
+  // A header claiming 2^31 - 1 words, followed by just two
+  std::stringstream buffer;
+  unsigned int words[] = {0xfffffffe, 1, 2};
+  buffer.write((const char *) words, sizeof(words));
+  reset_memory_usage();
+  bool rejected = false;
+  try {
+    read_binary(buffer);
+  } catch (gerryfudd::exception_utils::enriched_exception&) {
+    rejected = true;
+  }
+  assert_true(rejected, "A value shorter than its header says should not read.");
+  assert_peak_bytes_below(1 << 20);
+}
+
+TEST(mapped_column_views_feed_arithmetic)
+{
+  unsigned int mag_a[] = {0x80700230, 0xa0475d1e}, mag_b[] = {0xc00e00f2, 0x5fffffff, 0x1};
+  std::vector<BigInt> values = {BigInt(mag_a, 2, false), BigInt(), BigInt(mag_b, 3, true), BigInt(38)};
+  char path[] = "/tmp/bigIntColumnXXXXXX";
+  int fd = mkstemp(path);
+  close(fd);
+  {
+    std::ofstream out(path, std::ios::binary);
+    write_column(out, values);
+  }
+
+  MappedBigIntColumn column(path);
+  assert_equal<unsigned long>(column.size(), 4);
+  for (unsigned long i = 0; i < column.size(); i++) {
+    assert_equal<BigInt>(BigInt(column[i]), values[i]);
+  }
+  BigInt a = values[0], b = values[2];
+  assert_equal<BigInt>(a + column[2], a + b);
+  assert_equal<BigInt>(a - column[2], a - b);
+  assert_equal<BigInt>(a * column[2], a * b);
+  BigInt lazy_sum = lazy(column[0]) + column[2] - column[3];
+  assert_equal<BigInt>(lazy_sum, a + b - values[3]);
+  unlink(path);
+}
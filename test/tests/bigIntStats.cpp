@@ -0,0 +1,30 @@
+#include <math/BigInt.hpp>
+#include <math/BigIntStats.hpp>
+#include <Framework.hpp>
+#include <Assertions.inl>
+#include <vector>
+
+using namespace gerryfudd::math;
+using namespace gerryfudd::test;
+
+TEST(stats_count_the_multiplication_tier) {
+  std::vector<unsigned int> small(3, 0x12345678), large(100, 0x9abcdef0);
+  BigInt a(small.data(), small.size(), false), b(large.data(), large.size(), true), c{(unsigned int)7};
+  big_int_stats before = snapshot_thread_big_int_stats();
+  a * b;
+  a * c;
+  b * b;
+  big_int_stats after = snapshot_thread_big_int_stats();
+
+  if (!big_int_stats_enabled) {
+    assert_equal<unsigned long>(after[big_int_tier::multiply_to_len].calls, 0);
+    return;
+  }
+  assert_equal<unsigned long>(after[big_int_tier::multiply_by_long].calls - before[big_int_tier::multiply_by_long].calls, 1);
+  assert_equal<unsigned long>(after[big_int_tier::multiply_karatsuba].calls - before[big_int_tier::multiply_karatsuba].calls, 1);
+  // 100 words lands in the bucket for 64 to 127 words.
+  assert_equal<unsigned long>(after[big_int_tier::multiply_karatsuba].sizes[7] - before[big_int_tier::multiply_karatsuba].sizes[7], 1);
+  // The 3 by 100 product, plus Karatsuba's three 50 word sub-products
+  assert_equal<unsigned long>(after[big_int_tier::multiply_to_len].calls - before[big_int_tier::multiply_to_len].calls, 4);
+  assert_equal<unsigned long>(after[big_int_tier::multiply_to_len].sizes[6] - before[big_int_tier::multiply_to_len].sizes[6], 3);
+}
@@ -279,3 +279,19 @@ TEST(very_large_sums) {
   BigInt e(mag_e, 102, false), f(mag_f, 102, false), last_expected(mag_last, 103, false);
   assert_equal<BigInt>(e + f, last_expected);
 }
+
+TEST(sum_allocates_once)
+{
+  unsigned int mag_a[] = {0xffffffff, 0x80000000, 0x1, 0x2}, mag_b[] = {0x1, 0x80000000, 0x3, 0x4};
+  BigInt a(mag_a, 4, false), b(mag_b, 4, false), c(mag_b, 4, true);
+  reset_memory_usage();
+  BigInt sum = a + b;
+  assert_max_allocations(1);
+  // Room for a carry out of the top word takes one more word, and nothing else is live.
+  assert_peak_bytes_below(6 * sizeof(unsigned int));
+  reset_memory_usage();
+  BigInt difference = a + c;
+  assert_max_allocations(1);
+  // A difference never carries out, so it needs no more words than the longer operand.
+  assert_peak_bytes_below(5 * sizeof(unsigned int));
+}
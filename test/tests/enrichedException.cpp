@@ -0,0 +1,54 @@
+#include <Framework.hpp>
+#include <Assertions.inl>
+#include <sstream>
+#include <exception_utils/enriched_exception.hpp>
+
+using namespace gerryfudd::exception_utils;
+using namespace gerryfudd::test;
+
+void __attribute__((noinline)) throw_enriched(capture_level level) {
+  throw enriched_exception("enriched failure", level);
+}
+
+std::string printed(capture_level level) {
+  try {
+    throw_enriched(level);
+  } catch (enriched_exception& e) {
+    std::stringstream out;
+    out << e;
+    return out.str();
+  }
+  return "";
+}
+
+TEST(enriched_exception_without_trace)
+{
+  assert_equal<std::string>(printed(capture_level::none), "\n  enriched failure");
+}
+
+TEST(enriched_exception_trace_starts_at_thrower)
+{
+  capture_level levels[] = {capture_level::addresses, capture_level::full};
+  for (int i = 0; i < 2; i++) {
+    std::string trace = printed(levels[i]);
+    size_t first_frame = trace.find("\n    ");
+    std::string first_line = trace.substr(first_frame, trace.find("\n", first_frame + 1) - first_frame);
+    assert_true(first_line.find("throw_enriched(") != std::string::npos, "Expected the trace to start at the throwing function.");
+  }
+}
+
+TEST(enriched_exception_default_capture_level)
+{
+  assert_true(default_capture_level() == capture_level::addresses, "Expected addresses by default.");
+  set_default_capture_level(capture_level::none);
+  std::string message;
+  try {
+    throw enriched_exception("quiet");
+  } catch (enriched_exception& e) {
+    std::stringstream out;
+    out << e;
+    message = out.str();
+  }
+  set_default_capture_level(capture_level::addresses);
+  assert_equal<std::string>(message, "\n  quiet");
+}
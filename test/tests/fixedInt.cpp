@@ -0,0 +1,72 @@
+#include <Framework.hpp>
+#include <Assertions.inl>
+#include <math/FixedInt.hpp>
+
+using namespace gerryfudd::math;
+using namespace gerryfudd::test;
+
+// These run entirely at compile time.
+static_assert(FixedInt<64>(56) + FixedInt<64>(109) == FixedInt<64>(165));
+static_assert(FixedInt<64>(0xffffffff) + FixedInt<64>(1) == FixedInt<64>(0x10000) * FixedInt<64>(0x10000));
+static_assert(FixedInt<64>(22) - FixedInt<64>(38) == FixedInt<64>(16, true));
+static_assert(FixedInt<96>(0x80000000) * FixedInt<96>(0x80000000) * FixedInt<96>(4) == FixedInt<96>(0x10000) * FixedInt<96>(0x10000) * FixedInt<96>(0x10000) * FixedInt<96>(0x10000));
+static_assert((FixedInt<64>(7, true) * FixedInt<64>(6)).is_negative());
+
+TEST(fixed_int_round_trips_big_int)
+{
+  unsigned int mag[] = {0x80700230, 0xa0475d1e, 0x43875002, 0x213};
+  BigInt positive(mag, 4, false), negative(mag, 4, true);
+  assert_equal<BigInt>(FixedInt<256>(positive).to_big_int(), positive);
+  assert_equal<BigInt>(FixedInt<256>(negative).to_big_int(), negative);
+  assert_equal<BigInt>(FixedInt<256>().to_big_int(), BigInt());
+}
+
+TEST(fixed_int_rejects_values_that_do_not_fit)
+{
+  unsigned int mag[] = {0, 0, 0, 0, 0, 0, 0, 0x80000000};
+  bool rejected = false;
+  try {
+    FixedInt<256> value(BigInt(mag, 8, false));
+  } catch (gerryfudd::exception_utils::enriched_exception&) {
+    rejected = true;
+  }
+  assert_true(rejected, "A value using the sign bit of the top word should not fit.");
+}
+
+TEST(fixed_int_rejects_values_longer_than_an_unsigned_short)
+{
+  // 65537 words, which an unsigned short length would have counted as 1
+  vector<unsigned int> mag(65537, 0);
+  mag[0] = 1;
+  mag[65536] = 1;
+  bool rejected = false;
+  try {
+    FixedInt<256> value(BigInt(mag, false));
+  } catch (gerryfudd::exception_utils::enriched_exception&) {
+    rejected = true;
+  }
+  assert_true(rejected, "A value of 65537 words should not fit in 256 bits.");
+}
+
+TEST(fixed_int_arithmetic_matches_big_int)
+{
+  unsigned int mag_a[] = {0x80700230, 0xa0475d1e, 0x43875002}, mag_b[] = {0xc00e00f2, 0x5fffffff, 0xffffffff};
+  bool signs[][2] = {{false, false}, {false, true}, {true, false}, {true, true}};
+  for (int i = 0; i < 4; i++) {
+    BigInt a(mag_a, 3, signs[i][0]), b(mag_b, 3, signs[i][1]);
+    FixedInt<256> fa(a), fb(b);
+    assert_equal<BigInt>((fa + fb).to_big_int(), a + b);
+    assert_equal<BigInt>((fa - fb).to_big_int(), a - b);
+    assert_equal<BigInt>((fa * fb).to_big_int(), a * b);
+  }
+}
+
+TEST(fixed_int_multiplication_wraps)
+{
+  unsigned int mag_wrapped[] = {0xfffffffc, 0x7}, mag_wide[] = {4, 0xfffffff8, 3};
+  FixedInt<64> a(0xffffffff), b(0xffffffff);
+  // 4 * (2^32 - 1)^2 = 2^66 - 2^35 + 4, which is 4 - 2^35 modulo 2^64
+  assert_equal<BigInt>((a * b * FixedInt<64>(4)).to_big_int(), BigInt(mag_wrapped, 2, true));
+  assert_equal<BigInt>((a.resize<128>() * b.resize<128>() * FixedInt<128>(4)).to_big_int(), BigInt(mag_wide, 3, false));
+  assert_equal<BigInt>(FixedInt<64>(5, true).resize<128>().to_big_int(), BigInt(5, true));
+}
@@ -0,0 +1,40 @@
+#include <Framework.hpp>
+#include <Assertions.inl>
+#include <MemoryTracking.hpp>
+#include <vector>
+
+using namespace gerryfudd::test;
+
+TEST(memory_usage_counts_this_thread)
+{
+  reset_memory_usage();
+  std::vector<int> *first = new std::vector<int>(100), *second = new std::vector<int>(50);
+  delete first;
+  delete second;
+  memory_usage usage = current_memory_usage();
+  assert_equal<unsigned long>(usage.allocations, 4);
+  assert_equal<unsigned long>(usage.bytes, 2 * sizeof(std::vector<int>) + 150 * sizeof(int));
+  assert_equal<unsigned long>(usage.peak_bytes, usage.bytes);
+}
+
+TEST(memory_assertions_fail_past_their_limits)
+{
+  reset_memory_usage();
+  std::vector<char> buffer(1000);
+  // Check the passing limit first, since building a failure allocates too.
+  assert_peak_bytes_below(1001);
+  bool failed = false;
+  try {
+    assert_peak_bytes_below(1000);
+  } catch (AssertionFailure&) {
+    failed = true;
+  }
+  assert_true(failed, "Expected assert_peak_bytes_below(1000) to fail with 1000 bytes live.");
+  failed = false;
+  try {
+    assert_max_allocations(0);
+  } catch (AssertionFailure&) {
+    failed = true;
+  }
+  assert_true(failed, "Expected assert_max_allocations(0) to fail after an allocation.");
+}
@@ -0,0 +1,42 @@
+#include <Framework.hpp>
+#include <Assertions.inl>
+#include <chrono>
+#include <sstream>
+#include <profiling/sampling_profiler.hpp>
+
+using namespace gerryfudd::profiling;
+using namespace gerryfudd::test;
+
+unsigned long __attribute__((noinline)) spin_for_profiler(unsigned long rounds) {
+  unsigned long value = 0;
+  for (unsigned long i = 0; i < rounds; i++) {
+    value = value * 6364136223846793005UL + i;
+  }
+  return value;
+}
+
+TEST(profiler_samples_busy_code)
+{
+  // When --profile already samples the whole run there is nothing separate to check.
+  if (!start_profiling(1000)) {
+    return;
+  }
+  clear_profile();
+  // SIGPROF goes to whichever thread is running, so with --jobs other tests' samples land here too.
+  // Spin until this thread's frame shows up rather than until some number of samples.
+  const std::string frame = "profiler_samples_busy_code();spin_for_profiler(unsigned long)";
+  unsigned long value = 0;
+  bool found = false;
+  std::chrono::steady_clock::time_point give_up = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!found && std::chrono::steady_clock::now() < give_up) {
+    value += spin_for_profiler(1000000);
+    std::stringstream folded;
+    write_folded(folded);
+    found = folded.str().find(frame) != std::string::npos;
+  }
+  stop_profiling();
+  do_not_optimize(value);
+
+  assert_true(found, "Expected the busy function, called from this test, in the folded stacks.");
+  clear_profile();
+}